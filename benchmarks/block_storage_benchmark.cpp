@@ -0,0 +1,139 @@
+#include <iostream>
+#include <chrono>
+#include <array>
+#include <vector>
+#include <memory>
+#include <cmath>
+
+#include "game_objects/block_storage.h"
+
+/** Chunk sizes (same as in chunk class) */
+static constexpr UINT32
+  ChunkSizeX = 16,
+  ChunkSizeY = 256,
+  ChunkSizeZ = 16,
+  NumberOfBlocks = ChunkSizeX * ChunkSizeY * ChunkSizeZ;
+
+/** Number of benchmark repeats */
+static constexpr UINT32 NumberOfRepeats = 50;
+
+/**
+ * \brief Generate terrain-like block states function
+ * \return Block states in chunk order (stone below surface, grass on top, air above)
+ */
+static std::vector<BLOCK> GenerateTerrain( VOID )
+{
+  std::vector<BLOCK> Blocks(NumberOfBlocks);
+
+  for (UINT32 z = 0; z < ChunkSizeZ; z++)
+    for (UINT32 x = 0; x < ChunkSizeX; x++)
+    {
+      UINT32 MaxY = 65 + (UINT32)(15 * std::sin(x * 0.4) * std::cos(z * 0.3));
+
+      for (UINT32 y = 0; y <= MaxY; y++)
+        Blocks[z * ChunkSizeY * ChunkSizeX + y * ChunkSizeX + x].BlockTypeId = y == MaxY ? 2 : 1;
+    }
+
+  return Blocks;
+}
+
+/**
+ * \brief Measure function time
+ * \param[in] Func Function for measure
+ * \return Average time of one repeat in microseconds
+ */
+template<typename func>
+static DBL Measure( func Func )
+{
+  std::chrono::high_resolution_clock::time_point Start = std::chrono::high_resolution_clock::now();
+
+  for (UINT32 i = 0; i < NumberOfRepeats; i++)
+    Func();
+
+  std::chrono::high_resolution_clock::time_point End = std::chrono::high_resolution_clock::now();
+
+  return std::chrono::duration<DBL, std::micro>(End - Start).count() / NumberOfRepeats;
+}
+
+/**
+ * \brief Main function in program
+ * \param[in] ArgC Number of arguments
+ * \param[in] ArgV Array of arguments
+ * \return Error code (0-if success)
+ */
+INT main( INT ArgC, CHAR **ArgV )
+{
+  std::vector<BLOCK> Terrain = GenerateTerrain();
+  std::vector<UINT32> RandomOrder(NumberOfBlocks);
+  UINT32 Seed = 1;
+
+  for (UINT32 i = 0; i < NumberOfBlocks; i++)
+  {
+    Seed = Seed * 1664525 + 1013904223;
+    RandomOrder[i] = Seed % NumberOfBlocks;
+  }
+
+  std::unique_ptr<std::array<BLOCK, NumberOfBlocks>> Array = std::make_unique<std::array<BLOCK, NumberOfBlocks>>();
+  std::unique_ptr<block_storage> Storage = std::make_unique<block_storage>(NumberOfBlocks);
+  volatile UINT64 Sink = 0;
+
+  DBL ArraySetTime = Measure([&]( VOID )
+  {
+    for (UINT32 i = 0; i < NumberOfBlocks; i++)
+      (*Array)[i] = Terrain[i];
+  });
+
+  DBL StorageSetTime = Measure([&]( VOID )
+  {
+    for (UINT32 i = 0; i < NumberOfBlocks; i++)
+      Storage->Set(i, Terrain[i]);
+  });
+
+  DBL ArrayGetTime = Measure([&]( VOID )
+  {
+    UINT64 Sum = 0;
+
+    for (UINT32 i = 0; i < NumberOfBlocks; i++)
+      Sum += (*Array)[i].BlockTypeId;
+    Sink = Sink + Sum;
+  });
+
+  DBL StorageGetTime = Measure([&]( VOID )
+  {
+    UINT64 Sum = 0;
+
+    for (UINT32 i = 0; i < NumberOfBlocks; i++)
+      Sum += Storage->Get(i).BlockTypeId;
+    Sink = Sink + Sum;
+  });
+
+  DBL ArrayRandomGetTime = Measure([&]( VOID )
+  {
+    UINT64 Sum = 0;
+
+    for (UINT32 i : RandomOrder)
+      Sum += (*Array)[i].BlockTypeId;
+    Sink = Sink + Sum;
+  });
+
+  DBL StorageRandomGetTime = Measure([&]( VOID )
+  {
+    UINT64 Sum = 0;
+
+    for (UINT32 i : RandomOrder)
+      Sum += Storage->Get(i).BlockTypeId;
+    Sink = Sink + Sum;
+  });
+
+  std::cout << "Chunk blocks: " << NumberOfBlocks << ", palette size: " << Storage->GetPaletteSize() <<
+    ", bits per block: " << Storage->GetBitsPerBlock() << "\n\n";
+
+  std::cout << "                 array        palette\n";
+  std::cout << "memory (bytes)   " << sizeof(std::array<BLOCK, NumberOfBlocks>) << "      " <<
+    Storage->GetMemoryUsage() << "\n";
+  std::cout << "set (us)         " << ArraySetTime << "      " << StorageSetTime << "\n";
+  std::cout << "get (us)         " << ArrayGetTime << "      " << StorageGetTime << "\n";
+  std::cout << "random get (us)  " << ArrayRandomGetTime << "      " << StorageRandomGetTime << "\n";
+
+  return 0;
+}
@@ -0,0 +1,315 @@
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <cmath>
+
+#include "game_objects/chunk_blocks.h"
+#include "game_objects/block_type.h"
+#include "utils/epoch_manager.h"
+
+/** Streamed window radius in chunks */
+static constexpr INT32 WindowRadius = 4;
+
+/** Streamed window size in chunks */
+static constexpr INT32 WindowSize = 2 * WindowRadius + 1;
+
+/** Measurement time for one configuration in milliseconds */
+static constexpr INT MeasureTime = 500;
+
+/** Number of ray steps in one query */
+static constexpr UINT32 NumberOfRaySteps = 64;
+
+/** Number of ray hits (keeps queries from being optimized out) */
+static std::atomic<UINT64> Sink = 0;
+
+/**
+ * \brief Benchmark chunk
+ */
+struct BENCH_CHUNK
+{
+  /** Chunk position */
+  std::pair<INT32, INT32> Position;
+
+  /** Chunk blocks */
+  chunk_blocks Blocks;
+};
+
+/** Table access mode enumeration */
+enum class ACCESS_MODE
+{
+  MUTEX, // Readers and writer lock one mutex (as before)
+  EPOCH  // Readers enter epoch, writer retires unloaded chunks
+};
+
+/**
+ * \brief Streamed chunks table
+ */
+struct CHUNK_TABLE
+{
+  /** Published chunks (toroidal grid) */
+  std::unique_ptr<std::atomic<BENCH_CHUNK *>[]> Slots;
+
+  /** Mutex for mutex mode */
+  std::mutex Mutex;
+
+  /** Epoch manager for epoch mode */
+  epoch_manager Epochs;
+
+  /** Current window center x-coordinate */
+  std::atomic<INT32> CenterX = 0;
+
+  /**
+   * \brief Chunk table constructor
+   */
+  CHUNK_TABLE( VOID ) : Slots(new std::atomic<BENCH_CHUNK *>[WindowSize * WindowSize])
+  {
+    for (INT32 i = 0; i < WindowSize * WindowSize; i++)
+      Slots[i].store(nullptr);
+  }
+
+  /**
+   * \brief Chunk table destructor
+   */
+  ~CHUNK_TABLE( VOID )
+  {
+    for (INT32 i = 0; i < WindowSize * WindowSize; i++)
+      delete Slots[i].load();
+  }
+
+  /**
+   * \brief Get slot function
+   * \param[in] ChunkPos Chunk position
+   * \return Reference to slot
+   */
+  std::atomic<BENCH_CHUNK *> & GetSlot( const std::pair<INT32, INT32> &ChunkPos )
+  {
+    INT32 SlotX = (ChunkPos.first % WindowSize + WindowSize) % WindowSize;
+    INT32 SlotZ = (ChunkPos.second % WindowSize + WindowSize) % WindowSize;
+
+    return Slots[SlotZ * WindowSize + SlotX];
+  }
+};
+
+/**
+ * \brief Generate terrain-like chunk function
+ * \param[in] ChunkPos Chunk position
+ * \return Generated chunk
+ */
+static BENCH_CHUNK * GenerateChunk( const std::pair<INT32, INT32> &ChunkPos )
+{
+  BENCH_CHUNK *Chunk = new BENCH_CHUNK;
+  BLOCK Stone, Grass;
+
+  Stone.BlockTypeId = BLOCK_TYPE::StoneId;
+  Grass.BlockTypeId = BLOCK_TYPE::GrassId;
+  Chunk->Position = ChunkPos;
+
+  for (INT32 z = 0; z < chunk_blocks::ChunkSizeZ; z++)
+    for (INT32 x = 0; x < chunk_blocks::ChunkSizeX; x++)
+    {
+      DBL GlobalX = ChunkPos.first * chunk_blocks::ChunkSizeX + x;
+      DBL GlobalZ = ChunkPos.second * chunk_blocks::ChunkSizeZ + z;
+      INT32 MaxY = 65 + (INT32)(15 * std::sin(GlobalX * 0.1) * std::cos(GlobalZ * 0.07));
+
+      for (INT32 y = 0; y <= MaxY; y++)
+        Chunk->Blocks.Set(z * chunk_blocks::ChunkSizeY * chunk_blocks::ChunkSizeX + y * chunk_blocks::ChunkSizeX + x,
+                          y == MaxY ? Grass : Stone);
+    }
+
+  Chunk->Blocks.Compact();
+
+  return Chunk;
+}
+
+/**
+ * \brief Get published chunk function (caller must hold mutex or epoch guard)
+ * \param[in] Table Chunks table
+ * \param[in] ChunkPos Chunk position
+ * \return Pointer to chunk or nullptr
+ */
+static const BENCH_CHUNK * GetChunk( CHUNK_TABLE &Table, const std::pair<INT32, INT32> &ChunkPos )
+{
+  const BENCH_CHUNK *Chunk = Table.GetSlot(ChunkPos).load();
+
+  if (Chunk == nullptr || Chunk->Position != ChunkPos)
+    return nullptr;
+
+  return Chunk;
+}
+
+/**
+ * \brief Cast ray through chunks function (block picking like query)
+ * \param[in] Table Chunks table
+ * \param[in] Seed Random seed
+ * \return TRUE-if ray hit not air block, FALSE-if otherwise
+ */
+static BOOL CastRay( CHUNK_TABLE &Table, UINT32 Seed )
+{
+  INT32 CenterX = Table.CenterX.load(std::memory_order_relaxed);
+  DBL X = (CenterX + (DBL)(Seed % 2000) / 1000 - 1) * chunk_blocks::ChunkSizeX;
+  DBL Y = 90;
+  DBL Z = ((DBL)(Seed / 2000 % 2000) / 1000 - 1) * chunk_blocks::ChunkSizeZ;
+  DBL DirX = (DBL)(Seed % 7) / 7 - 0.5, DirY = -0.6, DirZ = (DBL)(Seed % 11) / 11 - 0.5;
+
+  for (UINT32 i = 0; i < NumberOfRaySteps; i++, X += DirX, Y += DirY, Z += DirZ)
+  {
+    INT32 BlockX = (INT32)std::floor(X), BlockY = (INT32)std::floor(Y), BlockZ = (INT32)std::floor(Z);
+    std::pair<INT32, INT32> ChunkPos(
+      (INT32)std::floor((DBL)BlockX / chunk_blocks::ChunkSizeX),
+      (INT32)std::floor((DBL)BlockZ / chunk_blocks::ChunkSizeZ));
+    const BENCH_CHUNK *Chunk = GetChunk(Table, ChunkPos);
+
+    if (Chunk == nullptr || BlockY < 0 || BlockY >= chunk_blocks::ChunkSizeY)
+      continue;
+
+    INT32 LocalX = BlockX - ChunkPos.first * chunk_blocks::ChunkSizeX;
+    INT32 LocalZ = BlockZ - ChunkPos.second * chunk_blocks::ChunkSizeZ;
+
+    if (!Chunk->Blocks.IsAir(LocalZ * chunk_blocks::ChunkSizeY * chunk_blocks::ChunkSizeX +
+                             BlockY * chunk_blocks::ChunkSizeX + LocalX))
+      return TRUE;
+  }
+
+  return FALSE;
+}
+
+/**
+ * \brief Replace chunk in table function (writer side)
+ * \param[in, out] Table Chunks table
+ * \param[in] Mode Access mode
+ * \param[in] NewChunk Generated chunk
+ */
+static VOID ReplaceChunk( CHUNK_TABLE &Table, ACCESS_MODE Mode, BENCH_CHUNK *NewChunk )
+{
+  std::atomic<BENCH_CHUNK *> &Slot = Table.GetSlot(NewChunk->Position);
+
+  if (Mode == ACCESS_MODE::MUTEX)
+  {
+    BENCH_CHUNK *OldChunk = nullptr;
+
+    {
+      std::lock_guard<std::mutex> Lock(Table.Mutex);
+
+      OldChunk = Slot.exchange(NewChunk);
+    }
+
+    delete OldChunk;
+  }
+  else
+  {
+    BENCH_CHUNK *OldChunk = Slot.exchange(NewChunk);
+
+    if (OldChunk != nullptr)
+      Table.Epochs.Retire([OldChunk]( VOID )
+      {
+        delete OldChunk;
+      });
+  }
+}
+
+/**
+ * \brief Run streaming with readers function
+ * \param[in] Mode Access mode
+ * \param[in] NumberOfReaders Number of reader threads
+ * \param[out] NumberOfStreamed Number of streamed chunks
+ * \return Number of queries per second for all readers
+ */
+static DBL Run( ACCESS_MODE Mode, UINT32 NumberOfReaders, UINT64 &NumberOfStreamed )
+{
+  CHUNK_TABLE Table;
+
+  for (INT32 z = -WindowRadius; z <= WindowRadius; z++)
+    for (INT32 x = -WindowRadius; x <= WindowRadius; x++)
+      Table.GetSlot({x, z}).store(GenerateChunk({x, z}));
+
+  std::atomic<BOOL> StopFlag = FALSE;
+  std::atomic<UINT64> NumberOfQueries = 0;
+  std::vector<std::thread> Readers;
+
+  NumberOfStreamed = 0;
+
+  std::thread Writer([&]( VOID )
+  {
+    while (!StopFlag.load())
+    {
+      INT32 NewX = Table.CenterX.load() + WindowRadius + 1;
+
+      /* Chunk column leaving window is replaced in same slots by entering one */
+      for (INT32 z = -WindowRadius; z <= WindowRadius; z++)
+      {
+        ReplaceChunk(Table, Mode, GenerateChunk({NewX, z}));
+        NumberOfStreamed++;
+      }
+
+      Table.CenterX.fetch_add(1);
+    }
+  });
+
+  for (UINT32 i = 0; i < NumberOfReaders; i++)
+    Readers.emplace_back([&, i]( VOID )
+    {
+      UINT32 Seed = i * 7919 + 1;
+      UINT64 Count = 0, Hits = 0;
+
+      while (!StopFlag.load(std::memory_order_relaxed))
+      {
+        Seed = Seed * 1664525 + 1013904223;
+
+        if (Mode == ACCESS_MODE::MUTEX)
+        {
+          std::lock_guard<std::mutex> Lock(Table.Mutex);
+
+          Hits += CastRay(Table, Seed >> 8);
+        }
+        else
+        {
+          epoch_manager::guard Guard(Table.Epochs);
+
+          Hits += CastRay(Table, Seed >> 8);
+        }
+
+        Count++;
+      }
+
+      NumberOfQueries += Count;
+      Sink += Hits;
+    });
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(MeasureTime));
+  StopFlag.store(TRUE);
+
+  Writer.join();
+  for (std::thread &Reader : Readers)
+    Reader.join();
+
+  Table.Epochs.Collect();
+
+  return NumberOfQueries.load() * 1000.0 / MeasureTime;
+}
+
+/**
+ * \brief Main function in program
+ * \param[in] ArgC Number of arguments
+ * \param[in] ArgV Array of arguments
+ * \return Error code (0-if success)
+ */
+INT main( INT ArgC, CHAR **ArgV )
+{
+  std::cout << "readers   mutex (queries/s)   epoch (queries/s)   streamed chunks (mutex/epoch)\n";
+
+  for (UINT32 NumberOfReaders : {1, 2, 4, 8})
+  {
+    UINT64 MutexStreamed = 0, EpochStreamed = 0;
+    DBL MutexRate = Run(ACCESS_MODE::MUTEX, NumberOfReaders, MutexStreamed);
+    DBL EpochRate = Run(ACCESS_MODE::EPOCH, NumberOfReaders, EpochStreamed);
+
+    std::cout << NumberOfReaders << "\t  " << (UINT64)MutexRate << "\t\t" << (UINT64)EpochRate << "\t\t    " <<
+      MutexStreamed << "/" << EpochStreamed << "\n";
+  }
+
+  return 0;
+}
@@ -0,0 +1,250 @@
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <array>
+#include <memory>
+#include <cmath>
+
+#include "game_objects/chunk_blocks.h"
+#include "game_objects/block_type.h"
+#include "render/chunk_mesher.h"
+
+/** Number of benchmark repeats */
+static constexpr UINT32 NumberOfRepeats = 50;
+
+/** Result of indexed fetch (keeps fetch loop from being optimized out) */
+static volatile UINT32 FetchResult;
+
+/**
+ * \brief Fill block types textures without texture atlas function
+ */
+static VOID FillTextures( VOID )
+{
+  /* Stone, grass top, grass side, grass bottom, glass */
+  const UINT32 NumberOfTextures = 5;
+
+  BLOCK_TYPE::TexCoords.assign(NumberOfTextures, {glm::vec2(1, 1), glm::vec2(1, 0), glm::vec2(0, 0), glm::vec2(0, 1)});
+  BLOCK_TYPE::TexRects.clear();
+
+  for (UINT32 i = 0; i < NumberOfTextures; i++)
+    BLOCK_TYPE::TexRects.push_back(glm::vec4(i / (FLT)NumberOfTextures, 0, 1 / (FLT)NumberOfTextures, 1));
+
+  for (UINT32 Side = 0; Side < 6; Side++)
+  {
+    BLOCK_TYPE::Table[BLOCK_TYPE::StoneId].Textures[Side] = 0;
+    BLOCK_TYPE::Table[BLOCK_TYPE::GrassId].Textures[Side] = 2;
+    BLOCK_TYPE::Table[BLOCK_TYPE::GlassId].Textures[Side] = 4;
+  }
+
+  BLOCK_TYPE::Table[BLOCK_TYPE::GrassId].Textures[BLOCK_TYPE::SideUp] = 1;
+  BLOCK_TYPE::Table[BLOCK_TYPE::GrassId].Textures[BLOCK_TYPE::SideDown] = 3;
+
+  BLOCK_TYPE::BuildFaceTextures();
+}
+
+/**
+ * \brief Fill chunk with terrain-like blocks function
+ * \param[in, out] Blocks Chunk blocks
+ */
+static VOID GenerateTerrain( chunk_blocks &Blocks )
+{
+  BLOCK Stone, Grass, Glass;
+
+  Stone.BlockTypeId = BLOCK_TYPE::StoneId;
+  Grass.BlockTypeId = BLOCK_TYPE::GrassId;
+  Glass.BlockTypeId = BLOCK_TYPE::GlassId;
+
+  for (UINT32 z = 0; z < chunk_blocks::ChunkSizeZ; z++)
+    for (UINT32 x = 0; x < chunk_blocks::ChunkSizeX; x++)
+    {
+      UINT32 MaxY = (ENABLE_CUBIC_CHUNKS ? 8 : 65) + (INT32)((ENABLE_CUBIC_CHUNKS ? 4 : 15) * std::sin(x * 0.4) * std::cos(z * 0.3));
+
+      for (UINT32 y = 0; y <= MaxY; y++)
+        Blocks.Set(z * chunk_blocks::ChunkSizeY * chunk_blocks::ChunkSizeX + y * chunk_blocks::ChunkSizeX + x,
+                   y == MaxY ? Grass : Stone);
+
+      /* Glass pillar on top of terrain */
+      if (x == 8 && z == 8)
+        for (UINT32 y = MaxY + 1; y < MaxY + 4 && y < (UINT32)chunk_blocks::ChunkSizeY; y++)
+          Blocks.Set(z * chunk_blocks::ChunkSizeY * chunk_blocks::ChunkSizeX + y * chunk_blocks::ChunkSizeX + x, Glass);
+    }
+
+  Blocks.Compact();
+}
+
+/**
+ * \brief Measure function time
+ * \param[in] Func Function for measure
+ * \return Average time of one repeat in microseconds
+ */
+template<typename func>
+static DBL Measure( func Func )
+{
+  std::chrono::high_resolution_clock::time_point Start = std::chrono::high_resolution_clock::now();
+
+  for (UINT32 i = 0; i < NumberOfRepeats; i++)
+    Func();
+
+  std::chrono::high_resolution_clock::time_point End = std::chrono::high_resolution_clock::now();
+
+  return std::chrono::duration<DBL, std::micro>(End - Start).count() / NumberOfRepeats;
+}
+
+/**
+ * \brief Print mesh statistics function
+ * \param[in] Name Mesher configuration name
+ * \param[in] Mesh Chunk mesh
+ * \param[in] Time Build time in microseconds
+ */
+static VOID PrintMesh( const CHAR *Name, const CHUNK_MESH &Mesh, DBL Time )
+{
+  UINT64 NumberOfQuads = Mesh.GetNumberOfQuads() + Mesh.GetNumberOfTransparentQuads();
+  UINT64 IndexSize = NumberOfQuads * 4 <= chunk_mesher::MaxNumberOfShortIndexVertices ? sizeof(UINT16) : sizeof(UINT32);
+
+  /* Vertex path draws 4 vertices and 6 indices per quad, vertex pulling uploads one packed face */
+  std::cout << Name << NumberOfQuads << "\t   " << NumberOfQuads * (4 * sizeof(VERTEX) + 6 * IndexSize) <<
+    "\t\t  " << NumberOfQuads * sizeof(UINT32) << "\t\t" << Time << "\n";
+}
+
+/**
+ * \brief Measure and print indexed vertex fetch function (same access pattern as indexed draw of quads)
+ * \param[in] Vertices Mesh vertices (4 per quad)
+ */
+template<typename index_type>
+static VOID MeasureIndexedFetch( const std::vector<VERTEX> &Vertices )
+{
+  std::vector<index_type> Indices(Vertices.size() / 4 * 6);
+
+  chunk_mesher::FillQuadIndices(Indices.data(), Vertices.size() / 4);
+
+  DBL Time = Measure([&]( VOID )
+  {
+    UINT32 Sum = 0;
+
+    for (index_type Index : Indices)
+      Sum += Vertices[Index].Position;
+
+    FetchResult = Sum;
+  });
+
+  std::cout << sizeof(index_type) * 8 << "-bit indices   " << Indices.size() * sizeof(index_type) << "\t\t" << Time << "\n";
+}
+
+/**
+ * \brief Main function in program
+ * \param[in] ArgC Number of arguments
+ * \param[in] ArgV Array of arguments
+ * \return Error code (0-if success)
+ */
+INT main( INT ArgC, CHAR **ArgV )
+{
+  FillTextures();
+
+  chunk_blocks Blocks;
+
+  GenerateTerrain(Blocks);
+
+  /* Same terrain is used as every neighbour, so only borders differ between runs */
+  CHUNK_BORDERS NoBorders, Borders;
+
+  for (UINT32 Face = 0; Face < BLOCK::NumberOfFaces; Face++)
+    chunk_mesher::GetBorder(Blocks, Face, Borders.Opaque[Face]);
+
+  CHUNK_MESH Mesh;
+
+  DBL BorderTime = Measure([&]( VOID )
+  {
+    std::vector<UINT64> Border;
+
+    for (UINT32 Face = 0; Face < BLOCK::NumberOfFaces; Face++)
+      chunk_mesher::GetBorder(Blocks, Face, Border);
+  });
+
+  std::cout << "mesher              quads   vertex bytes   packed bytes   time (us)\n";
+
+  DBL Time = Measure([&]( VOID ){ chunk_mesher::Build(Blocks, NoBorders, CHUNK_POS(), Mesh, FALSE); });
+  PrintMesh("per-face            ", Mesh, Time);
+
+  Time = Measure([&]( VOID ){ chunk_mesher::Build(Blocks, Borders, CHUNK_POS(), Mesh, FALSE); });
+  PrintMesh("per-face + borders  ", Mesh, Time);
+
+  Time = Measure([&]( VOID ){ chunk_mesher::Build(Blocks, NoBorders, CHUNK_POS(), Mesh, TRUE); });
+  PrintMesh("greedy              ", Mesh, Time);
+
+  Time = Measure([&]( VOID ){ chunk_mesher::Build(Blocks, Borders, CHUNK_POS(), Mesh, TRUE); });
+  PrintMesh("greedy + borders    ", Mesh, Time);
+
+  /* Far chunks are meshed greedily from downsampled blocks, their border faces aren't culled (skirts) */
+  for (UINT32 Lod = 1; Lod < chunk_mesher::NumberOfLods; Lod++)
+  {
+    Time = Measure([&]( VOID )
+    {
+      std::unique_ptr<chunk_blocks> Coarse = std::make_unique<chunk_blocks>();
+
+      chunk_mesher::Downsample(Blocks, Lod, *Coarse);
+      chunk_mesher::Build(*Coarse, NoBorders, CHUNK_POS(), Mesh, TRUE);
+    });
+    PrintMesh(Lod == 1 ? "lod 1 + skirts      " : "lod 2 + skirts      ", Mesh, Time);
+  }
+
+  /* Block edit re-meshes quads of one section, other sections quads are reused */
+  std::array<std::vector<chunk_mesher::QUAD>, chunk_blocks::NumberOfSections> SectionQuads;
+  UINT32 EditedSection = Blocks.GetHeight(5, 5) / chunk_blocks::SectionSize;
+
+  for (UINT32 SectionId = 0; SectionId < chunk_blocks::NumberOfSections; SectionId++)
+    chunk_mesher::BuildSectionQuads(Blocks, Borders, SectionId, SectionQuads[SectionId]);
+
+  DBL SectionTime = Measure([&]( VOID )
+  {
+    SectionQuads[EditedSection].clear();
+    chunk_mesher::BuildSectionQuads(Blocks, Borders, EditedSection, SectionQuads[EditedSection]);
+
+    Mesh.Clear();
+
+    for (const std::vector<chunk_mesher::QUAD> &Quads : SectionQuads)
+      chunk_mesher::AddQuads(Mesh, Quads, CHUNK_POS());
+  });
+
+  /* Reloaded chunk with unchanged blocks reads saved quads instead of re-mesh */
+  CHUNK_MESH_CACHE Cache;
+  std::vector<BYTE> CacheData;
+
+  Cache.SectionQuads = SectionQuads;
+  Cache.Save(CacheData);
+
+  DBL CacheTime = Measure([&]( VOID )
+  {
+    std::vector<BYTE> BlocksData;
+
+    Blocks.Save(BlocksData);
+    chunk_mesher::GetHash(BlocksData.data(), BlocksData.size());
+    Cache.Load(CacheData.data(), CacheData.size());
+
+    Mesh.Clear();
+
+    for (const std::vector<chunk_mesher::QUAD> &Quads : Cache.SectionQuads)
+      chunk_mesher::AddQuads(Mesh, Quads, CHUNK_POS());
+  });
+
+  std::cout << "\nneighbour borders build (6 faces, us): " << BorderTime << "\n";
+  std::cout << "section re-mesh + mesh assembly (us): " << SectionTime << "\n";
+  std::cout << "saved mesh load + mesh assembly (" << CacheData.size() << " bytes, us): " << CacheTime << "\n";
+
+  /* Indexed fetch of largest (per-face) mesh */
+  std::vector<VERTEX> Vertices;
+
+  chunk_mesher::Build(Blocks, NoBorders, CHUNK_POS(), Mesh, FALSE);
+
+  for (const std::vector<VERTEX> &FaceVertices : Mesh.Vertices)
+    Vertices.insert(Vertices.end(), FaceVertices.begin(), FaceVertices.end());
+  Vertices.insert(Vertices.end(), Mesh.TransparentVertices.begin(), Mesh.TransparentVertices.end());
+
+  if (Vertices.size() <= chunk_mesher::MaxNumberOfShortIndexVertices)
+  {
+    std::cout << "\nindices         index bytes   fetch time (us)\n";
+    MeasureIndexedFetch<UINT32>(Vertices);
+    MeasureIndexedFetch<UINT16>(Vertices);
+  }
+
+  return 0;
+}
@@ -0,0 +1,193 @@
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <cmath>
+#include <cfloat>
+#include <algorithm>
+
+#include "game_objects/chunk_blocks.h"
+#include "game_objects/block_type.h"
+
+/** Number of blocks in chunk */
+static constexpr UINT32 NumberOfBlocks =
+  chunk_blocks::ChunkSizeX * chunk_blocks::ChunkSizeY * chunk_blocks::ChunkSizeZ;
+
+/** Number of benchmark repeats */
+static constexpr UINT32 NumberOfRepeats = 50;
+
+/**
+ * \brief Fill chunk with terrain-like blocks function
+ * \param[in, out] Blocks Chunk blocks
+ */
+static VOID GenerateTerrain( chunk_blocks &Blocks )
+{
+  BLOCK Stone, Grass;
+
+  Stone.BlockTypeId = BLOCK_TYPE::StoneId;
+  Grass.BlockTypeId = BLOCK_TYPE::GrassId;
+
+  for (UINT32 z = 0; z < chunk_blocks::ChunkSizeZ; z++)
+    for (UINT32 x = 0; x < chunk_blocks::ChunkSizeX; x++)
+    {
+      UINT32 MaxY = 65 + (INT32)(15 * std::sin(x * 0.4) * std::cos(z * 0.3));
+
+      for (UINT32 y = 0; y <= MaxY; y++)
+        Blocks.Set(z * chunk_blocks::ChunkSizeY * chunk_blocks::ChunkSizeX + y * chunk_blocks::ChunkSizeX + x,
+                   y == MaxY ? Grass : Stone);
+    }
+
+  Blocks.Compact();
+}
+
+/**
+ * \brief Count visible up borders function (meshing-like walk)
+ * \param[in] Blocks Chunk blocks
+ * \param[in] SkipEmpty Skip empty sections flag
+ * \param[in] ClampY Clamp walk by occupied Y bounds flag
+ * \return Number of visible up borders
+ */
+static UINT64 CountUpBorders( const chunk_blocks &Blocks, BOOL SkipEmpty, BOOL ClampY )
+{
+  UINT64 Count = 0;
+
+  for (UINT32 Section = 0; Section < chunk_blocks::NumberOfSections; Section++)
+  {
+    if (SkipEmpty && Blocks.IsSectionEmpty(Section))
+      continue;
+
+    INT32 SectionMinY = Section * chunk_blocks::SectionSize;
+    INT32 SectionMaxY = (Section + 1) * chunk_blocks::SectionSize - 1;
+
+    if (ClampY)
+    {
+      SectionMinY = std::max(SectionMinY, Blocks.GetMinY());
+      SectionMaxY = std::min(SectionMaxY, Blocks.GetMaxY());
+    }
+
+    for (UINT32 z = 0; z < chunk_blocks::ChunkSizeZ; z++)
+      for (INT32 y = SectionMinY; y <= SectionMaxY; y++)
+        for (UINT32 x = 0; x < chunk_blocks::ChunkSizeX; x++)
+        {
+          UINT32 Index = z * chunk_blocks::ChunkSizeY * chunk_blocks::ChunkSizeX + y * chunk_blocks::ChunkSizeX + x;
+
+          if (Blocks.Get(Index).BlockTypeId != BLOCK_TYPE::AirId &&
+              (y == chunk_blocks::ChunkSizeY - 1 ||
+               BLOCK_TYPE::Table[Blocks.Get(Index + chunk_blocks::ChunkSizeX).BlockTypeId].Alpha < 1 - FLT_EPSILON))
+            Count++;
+        }
+  }
+
+  return Count;
+}
+
+/**
+ * \brief Count visible up borders with opacity bitsets function
+ * \param[in] Blocks Chunk blocks
+ * \return Number of visible up borders
+ */
+static UINT64 CountUpBordersBitset( const chunk_blocks &Blocks )
+{
+  const UINT32 WordsPerLayer = chunk_blocks::ChunkSizeX * chunk_blocks::ChunkSizeY / 64;
+  const std::array<UINT64, chunk_blocks::NumberOfBitsetWords> &Opaque = Blocks.GetOpaqueBits();
+  const std::array<UINT64, chunk_blocks::NumberOfBitsetWords> &NotAir = Blocks.GetNotAirBits();
+  UINT64 Count = 0;
+
+  for (UINT32 i = 0; i < chunk_blocks::NumberOfBitsetWords; i++)
+  {
+    UINT64 OpaqueAbove = Opaque[i] >> chunk_blocks::ChunkSizeX;
+
+    if ((i + 1) % WordsPerLayer != 0)
+      OpaqueAbove |= Opaque[i + 1] << (64 - chunk_blocks::ChunkSizeX);
+
+    for (UINT64 Visible = NotAir[i] & ~OpaqueAbove; Visible != 0; Visible &= Visible - 1)
+      Count++;
+  }
+
+  return Count;
+}
+
+/**
+ * \brief Measure function time
+ * \param[in] Func Function for measure
+ * \return Average time of one repeat in microseconds
+ */
+template<typename func>
+static DBL Measure( func Func )
+{
+  std::chrono::high_resolution_clock::time_point Start = std::chrono::high_resolution_clock::now();
+
+  for (UINT32 i = 0; i < NumberOfRepeats; i++)
+    Func();
+
+  std::chrono::high_resolution_clock::time_point End = std::chrono::high_resolution_clock::now();
+
+  return std::chrono::duration<DBL, std::micro>(End - Start).count() / NumberOfRepeats;
+}
+
+/**
+ * \brief Main function in program
+ * \param[in] ArgC Number of arguments
+ * \param[in] ArgV Array of arguments
+ * \return Error code (0-if success)
+ */
+INT main( INT ArgC, CHAR **ArgV )
+{
+  chunk_blocks Blocks;
+
+  GenerateTerrain(Blocks);
+
+  const CHAR *KindNames[3] = {"empty", "uniform", "palette"};
+  UINT32 KindCount[3] = {};
+  UINT64 KindMemory[3] = {};
+  UINT64 KindSaveSize[3] = {};
+
+  for (UINT32 i = 0; i < chunk_blocks::NumberOfSections; i++)
+  {
+    const chunk_section &Section = Blocks.GetSection(i);
+    UINT32 Kind = (UINT32)Section.GetKind();
+    std::vector<BYTE> Bytes;
+
+    Section.Save(Bytes);
+
+    KindCount[Kind]++;
+    KindMemory[Kind] += Section.GetMemoryUsage();
+    KindSaveSize[Kind] += Bytes.size();
+  }
+
+  std::cout << "kind       sections   memory (bytes)   saved (bytes)\n";
+
+  for (UINT32 i = 0; i < 3; i++)
+    std::cout << KindNames[i] << "\t   " << KindCount[i] << "\t      " << KindMemory[i] << "\t       " <<
+      KindSaveSize[i] << "\n";
+
+  std::cout << "\nchunk memory (bytes): sections " << Blocks.GetMemoryUsage() <<
+    ", array " << NumberOfBlocks * sizeof(BLOCK) << "\n";
+
+  volatile UINT64 Sink = 0;
+
+  DBL FullTime = Measure([&]( VOID )
+  {
+    Sink = Sink + CountUpBorders(Blocks, FALSE, FALSE);
+  });
+
+  DBL SkipTime = Measure([&]( VOID )
+  {
+    Sink = Sink + CountUpBorders(Blocks, TRUE, FALSE);
+  });
+
+  DBL ClampTime = Measure([&]( VOID )
+  {
+    Sink = Sink + CountUpBorders(Blocks, TRUE, TRUE);
+  });
+
+  DBL BitsetTime = Measure([&]( VOID )
+  {
+    Sink = Sink + CountUpBordersBitset(Blocks);
+  });
+
+  std::cout << "meshing walk (us): all sections " << FullTime << ", skip empty " << SkipTime <<
+    ", clamp by occupied Y " << ClampTime << ", opacity bitset " << BitsetTime << "\n";
+  std::cout << "up borders: " << CountUpBorders(Blocks, TRUE, TRUE) << " (bitset " << CountUpBordersBitset(Blocks) << ")\n";
+
+  return 0;
+}
@@ -0,0 +1,142 @@
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <cmath>
+
+#include "game_objects/chunk_blocks.h"
+#include "game_objects/block_type.h"
+#include "render/greedy_mesher.h"
+
+/** Number of benchmark repeats */
+static constexpr UINT32 NumberOfRepeats = 50;
+
+/**
+ * \brief Fill block types textures without texture atlas function
+ */
+static VOID FillTextures( VOID )
+{
+  /* Stone, grass top, grass side, grass bottom, glass */
+  const UINT32 NumberOfTextures = 5;
+
+  BLOCK_TYPE::TexCoords.assign(NumberOfTextures, {glm::vec2(1, 1), glm::vec2(1, 0), glm::vec2(0, 0), glm::vec2(0, 1)});
+  BLOCK_TYPE::TexRects.clear();
+
+  for (UINT32 i = 0; i < NumberOfTextures; i++)
+    BLOCK_TYPE::TexRects.push_back(glm::vec4(i / (FLT)NumberOfTextures, 0, 1 / (FLT)NumberOfTextures, 1));
+
+  for (UINT32 Side = 0; Side < 6; Side++)
+  {
+    BLOCK_TYPE::Table[BLOCK_TYPE::StoneId].Textures[Side] = 0;
+    BLOCK_TYPE::Table[BLOCK_TYPE::GrassId].Textures[Side] = 2;
+    BLOCK_TYPE::Table[BLOCK_TYPE::GlassId].Textures[Side] = 4;
+  }
+
+  BLOCK_TYPE::Table[BLOCK_TYPE::GrassId].Textures[BLOCK_TYPE::SideUp] = 1;
+  BLOCK_TYPE::Table[BLOCK_TYPE::GrassId].Textures[BLOCK_TYPE::SideDown] = 3;
+
+  BLOCK_TYPE::BuildFaceTextures();
+}
+
+/**
+ * \brief Fill chunk with terrain-like blocks function
+ * \param[in, out] Blocks Chunk blocks
+ */
+static VOID GenerateTerrain( chunk_blocks &Blocks )
+{
+  BLOCK Stone, Grass, Glass;
+
+  Stone.BlockTypeId = BLOCK_TYPE::StoneId;
+  Grass.BlockTypeId = BLOCK_TYPE::GrassId;
+  Glass.BlockTypeId = BLOCK_TYPE::GlassId;
+
+  for (UINT32 z = 0; z < chunk_blocks::ChunkSizeZ; z++)
+    for (UINT32 x = 0; x < chunk_blocks::ChunkSizeX; x++)
+    {
+      UINT32 MaxY = (ENABLE_CUBIC_CHUNKS ? 8 : 65) + (INT32)((ENABLE_CUBIC_CHUNKS ? 4 : 15) * std::sin(x * 0.4) * std::cos(z * 0.3));
+
+      for (UINT32 y = 0; y <= MaxY; y++)
+        Blocks.Set(z * chunk_blocks::ChunkSizeY * chunk_blocks::ChunkSizeX + y * chunk_blocks::ChunkSizeX + x,
+                   y == MaxY ? Grass : Stone);
+
+      /* Glass pillar on top of terrain */
+      if (x == 8 && z == 8)
+        for (UINT32 y = MaxY + 1; y < MaxY + 4 && y < (UINT32)chunk_blocks::ChunkSizeY; y++)
+          Blocks.Set(z * chunk_blocks::ChunkSizeY * chunk_blocks::ChunkSizeX + y * chunk_blocks::ChunkSizeX + x, Glass);
+    }
+
+  Blocks.Compact();
+}
+
+/**
+ * \brief Measure function time
+ * \param[in] Func Function for measure
+ * \return Average time of one repeat in microseconds
+ */
+template<typename func>
+static DBL Measure( func Func )
+{
+  std::chrono::high_resolution_clock::time_point Start = std::chrono::high_resolution_clock::now();
+
+  for (UINT32 i = 0; i < NumberOfRepeats; i++)
+    Func();
+
+  std::chrono::high_resolution_clock::time_point End = std::chrono::high_resolution_clock::now();
+
+  return std::chrono::duration<DBL, std::micro>(End - Start).count() / NumberOfRepeats;
+}
+
+/**
+ * \brief Main function in program
+ * \param[in] ArgC Number of arguments
+ * \param[in] ArgV Array of arguments
+ * \return Error code (0-if success)
+ */
+INT main( INT ArgC, CHAR **ArgV )
+{
+  FillTextures();
+
+  chunk_blocks Blocks;
+
+  GenerateTerrain(Blocks);
+
+  CHUNK_BORDERS Borders;
+  std::vector<greedy_mesher::QUAD> Quads;
+  std::vector<VERTEX> Vertices;
+
+  /* Full mesh is built by sections, same as chunks manager meshes chunk */
+  auto MeshChunk = [&]( BOOL Greedy )
+  {
+    Quads.clear();
+
+    for (UINT32 SectionId = 0; SectionId < chunk_blocks::NumberOfSections; SectionId++)
+      chunk_mesher::BuildSectionQuads(Blocks, Borders, SectionId, Quads, Greedy);
+
+    Vertices.resize(Quads.size() * 4);
+
+    for (UINT64 i = 0; i < Quads.size(); i++)
+      chunk_mesher::GetQuadVertices(Quads[i], Vertices.data() + i * 4);
+  };
+
+  /* Per-face mesher emits one quad for every visible face */
+  DBL PerFaceTime = Measure([&]( VOID ){ MeshChunk(FALSE); });
+  UINT64 PerFaceQuads = Quads.size();
+
+  DBL GreedyTime = Measure([&]( VOID ){ MeshChunk(TRUE); });
+  UINT64 GreedyQuads = Quads.size();
+
+  /* Block edit re-meshes section of block instead of whole chunk */
+  UINT32 SectionId = Blocks.GetHeight(5, 5) / chunk_blocks::SectionSize;
+
+  DBL SectionTime = Measure([&]( VOID )
+  {
+    Quads.clear();
+    chunk_mesher::BuildSectionQuads(Blocks, Borders, SectionId, Quads, TRUE);
+  });
+
+  std::cout << "mesher     quads   vertices   time (us)\n";
+  std::cout << "per-face   " << PerFaceQuads << "\t   " << PerFaceQuads * 4 << "\t      " << PerFaceTime << "\n";
+  std::cout << "greedy     " << GreedyQuads << "\t   " << GreedyQuads * 4 << "\t      " << GreedyTime << "\n";
+  std::cout << "\ngreedy block update (1 section, us): " << SectionTime << "\n";
+
+  return 0;
+}
@@ -0,0 +1,116 @@
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <random>
+#include <algorithm>
+
+#include "utils/range_allocator.h"
+
+/** Number of chunk geometries (render distance 5, one geometry waiting for swap) */
+static constexpr UINT32 NumberOfChunks = 11 * 11 + 1;
+
+/** Number of simulated re-meshes */
+static constexpr UINT32 NumberOfRemeshes = 1000000;
+
+/** Maximal number of quads in fixed chunk slot (column chunk) */
+static constexpr UINT64 SlotSize = 16 * 256 * 16 * 3 / 32;
+
+/**
+ * \brief Get number of quads of random chunk mesh function
+ * \param[in, out] Random Random generator
+ * \return Number of quads (mostly few hundreds, sometimes thousands)
+ */
+static UINT64 GetMeshSize( std::mt19937_64 &Random )
+{
+  std::lognormal_distribution<DBL> Distribution(6, 0.8);
+
+  return std::clamp<UINT64>((UINT64)Distribution(Random), 1, SlotSize * 2);
+}
+
+/**
+ * \brief Print allocator statistics function
+ * \param[in] Name Statistics name
+ * \param[in] Stats Allocator statistics
+ */
+static VOID PrintStats( const CHAR *Name, const range_allocator::STATS &Stats )
+{
+  std::cout << Name << Stats.AllocatedSize << "\t\t" << Stats.Capacity - Stats.AllocatedSize << "\t\t" <<
+    Stats.NumberOfFreeRanges << "\t\t" << Stats.LargestFreeRange << "\t\t" << Stats.GetFragmentation() << "\n";
+}
+
+/**
+ * \brief Main function in program
+ * \param[in] ArgC Number of arguments
+ * \param[in] ArgV Array of arguments
+ * \return Error code (0-if success)
+ */
+INT main( INT ArgC, CHAR **ArgV )
+{
+  std::mt19937_64 Random(30);
+
+  /* Space is quarter of fixed slots reservation */
+  range_allocator Allocator(NumberOfChunks * SlotSize / 4);
+  std::vector<UINT32> Chunks;
+  UINT64 NumberOfOversized = 0;
+
+  for (UINT32 i = 0; i < NumberOfChunks; i++)
+  {
+    UINT64 Size = GetMeshSize(Random);
+
+    NumberOfOversized += Size > SlotSize;
+    Chunks.push_back(*Allocator.Allocate(Size));
+  }
+
+  std::cout << "allocator state     allocated     free          free ranges   largest free  fragmentation\n";
+  PrintStats("initial             ", Allocator.GetStats());
+
+  /* Re-meshed chunk gets new geometry before old one is freed, size changes with edit or level of detail */
+  std::uniform_int_distribution<UINT32> ChunkDistribution(0, NumberOfChunks - 1);
+  std::uniform_real_distribution<DBL> ScaleDistribution(0.5, 1.5);
+  std::vector<std::pair<UINT32, UINT64>> Remeshes;
+
+  for (UINT32 i = 0; i < NumberOfRemeshes; i++)
+  {
+    UINT32 ChunkId = ChunkDistribution(Random);
+
+    /* Every tenth re-mesh is new chunk, others are edits of old one */
+    Remeshes.push_back({ChunkId, i % 10 == 0 ? GetMeshSize(Random) : 0});
+  }
+
+  UINT64 NumberOfFailures = 0;
+  std::vector<UINT64> Sizes(NumberOfChunks);
+
+  for (UINT32 i = 0; i < NumberOfChunks; i++)
+    Sizes[i] = Allocator.GetSize(Chunks[i]);
+
+  std::chrono::high_resolution_clock::time_point Start = std::chrono::high_resolution_clock::now();
+
+  for (const std::pair<UINT32, UINT64> &Remesh : Remeshes)
+  {
+    UINT64 Size = Remesh.second != 0 ? Remesh.second :
+      std::clamp<UINT64>((UINT64)(Sizes[Remesh.first] * ScaleDistribution(Random)), 1, SlotSize * 2);
+    std::optional<UINT32> NewRange = Allocator.Allocate(Size);
+
+    if (!NewRange)
+    {
+      NumberOfFailures++;
+      continue;
+    }
+
+    Allocator.Free(Chunks[Remesh.first]);
+    Chunks[Remesh.first] = *NewRange;
+    Sizes[Remesh.first] = Size;
+  }
+
+  std::chrono::high_resolution_clock::time_point End = std::chrono::high_resolution_clock::now();
+
+  PrintStats("after re-meshes     ", Allocator.GetStats());
+
+  std::cout << "\nre-mesh allocation + free (ns): " <<
+    std::chrono::duration<DBL, std::nano>(End - Start).count() / NumberOfRemeshes << "\n";
+  std::cout << "failed allocations: " << NumberOfFailures << " of " << NumberOfRemeshes << "\n";
+  std::cout << "fixed slots reservation: " << NumberOfChunks * SlotSize << ", initial meshes larger than slot: " <<
+    NumberOfOversized << "\n";
+
+  return 0;
+}
@@ -0,0 +1,70 @@
+#version 450 core
+#extension GL_GOOGLE_include_directive : require
+//#extension GL_EXT_debug_printf : require
+
+#include "../glsl_def.glsl"
+
+/* Must match uniform_buffer::MaxNumberOfTextures */
+#define MAX_NUMBER_OF_TEXTURES 32
+
+layout(push_constant) uniform PUSH_CONSTANTS_STRUCTURE
+{
+  vec3 ChunkOrigin;
+  UINT FirstFace;
+} PushConstants;
+
+layout (binding = 1) uniform UNIFORM_BUFFER
+{
+  mat4 MatrWVP;
+  vec4 TexRects[MAX_NUMBER_OF_TEXTURES];
+  vec4 TexAlphas[MAX_NUMBER_OF_TEXTURES / 4];
+} UniformBuffer;
+
+/* Packed faces (see chunk_mesher::PackQuad) */
+layout (std430, binding = 2) readonly buffer FACES_BUFFER
+{
+  UINT Faces[];
+} FacesBuffer;
+
+layout (location = 0) out vec2 OutTexCoord;
+layout (location = 1) out FLT OutAlpha;
+layout (location = 2) flat out vec4 OutTexRect;
+
+/* Normal, first and second axes for every face direction */
+const ivec3 FaceAxes[6] = ivec3[6](ivec3(0, 1, 2), ivec3(0, 1, 2), ivec3(1, 0, 2), ivec3(1, 0, 2),
+                                   ivec3(2, 1, 0), ivec3(2, 1, 0));
+
+/* Quad corner for every vertex of two triangles */
+const UINT QuadIndices[6] = UINT[6](0, 1, 2, 0, 2, 3);
+
+/* Texture coordinates of quad corners in tile */
+const vec2 TexCoords[4] = vec2[4](vec2(1, 1), vec2(1, 0), vec2(0, 0), vec2(0, 1));
+
+/**
+ * \brief Main shader function
+ */
+VOID main( VOID )
+{
+  UINT Face = FacesBuffer.Faces[PushConstants.FirstFace + gl_VertexIndex / 6];
+  UINT Corner = QuadIndices[gl_VertexIndex % 6];
+
+  UINT Direction = (Face >> 16) & 7;
+  INT SizeA = INT((Face >> 19) & 15) + 1;
+  INT SizeB = INT((Face >> 23) & 15) + 1;
+  UINT Texture = Face >> 27;
+  ivec3 Axes = FaceAxes[Direction];
+  ivec3 Pos = ivec3(Face & 15, (Face >> 4) & 255, (Face >> 12) & 15);
+
+  /* Faces of positive directions lie on far side of block */
+  Pos[Axes.x] += INT(Direction & 1);
+
+  if (Corner == 1 || Corner == 2)
+    Pos[Axes.y] += SizeA;
+  if (Corner == 2 || Corner == 3)
+    Pos[Axes.z] += SizeB;
+
+  gl_Position = UniformBuffer.MatrWVP * vec4(PushConstants.ChunkOrigin + vec3(Pos), 1);
+  OutTexCoord = TexCoords[Corner] * vec2(SizeB, SizeA);
+  OutAlpha = UniformBuffer.TexAlphas[Texture / 4][Texture % 4];
+  OutTexRect = UniformBuffer.TexRects[Texture];
+}
\ No newline at end of file
@@ -6,6 +6,7 @@
 
 layout (location = 0) in vec2 TexCoord;
 layout (location = 1) in FLT Alpha;
+layout (location = 2) flat in vec4 TexRect;
 
 layout(binding = 0) uniform sampler2D TextureAtlas;
 
@@ -16,7 +17,8 @@ layout (location = 0) out vec4 OutColor;
  */
 VOID main( VOID )
 {
-  vec4 ResultColor = texture(TextureAtlas, TexCoord);
+  /* Texture coordinates are in tiles, so merged faces repeat tile */
+  vec4 ResultColor = texture(TextureAtlas, TexRect.xy + fract(TexCoord) * TexRect.zw);
   
   ResultColor.a *= Alpha;
   
@@ -4,29 +4,41 @@
 
 #include "../glsl_def.glsl"
 
-layout (location = 0) in vec3 Position;
+/* Must match uniform_buffer::MaxNumberOfTextures */
+#define MAX_NUMBER_OF_TEXTURES 32
+
+/* Position in chunk (bits 0-7 - x, 8-23 - y, 24-31 - z, see VERTEX::PackPosition) */
+layout (location = 0) in UINT Position;
 layout (location = 1) in FLT Alpha;
 layout (location = 2) in vec2 TexCoord;
+layout (location = 3) in UINT Texture;
 
-//layout(push_constant) uniform PUSH_CONSTANTS_STRUCTURE
-//{
-//  mat4 MatrWVP;
-//} PushConstants;
+layout(push_constant) uniform PUSH_CONSTANTS_STRUCTURE
+{
+  vec3 ChunkOrigin;
+  UINT FirstFace;
+} PushConstants;
 
 layout (binding = 1) uniform UNIFORM_BUFFER
 {
   mat4 MatrWVP;
+  vec4 TexRects[MAX_NUMBER_OF_TEXTURES];
+  vec4 TexAlphas[MAX_NUMBER_OF_TEXTURES / 4];
 } UniformBuffer;
 
 layout (location = 0) out vec2 OutTexCoord;
 layout (location = 1) out FLT OutAlpha;
+layout (location = 2) flat out vec4 OutTexRect;
 
 /**
  * \brief Main shader function
  */
 VOID main( VOID )
 {
-  gl_Position = UniformBuffer.MatrWVP * vec4(Position, 1);
+  vec3 Pos = vec3(Position & 0xFFu, (Position >> 8) & 0xFFFFu, Position >> 24);
+
+  gl_Position = UniformBuffer.MatrWVP * vec4(PushConstants.ChunkOrigin + Pos, 1);
   OutTexCoord = TexCoord;
   OutAlpha = Alpha;
+  OutTexRect = UniformBuffer.TexRects[Texture];
 }
\ No newline at end of file
@@ -11,6 +11,8 @@ typedef bool BOOL;
 typedef int32_t INT32;
 typedef uint32_t UINT32;
 typedef uint8_t BYTE;
+typedef int16_t INT16;
+typedef uint16_t UINT16;
 typedef uint16_t WORD;
 typedef uint32_t DWORD;
 typedef char CHAR;
@@ -26,6 +28,15 @@ typedef uint64_t UINT64;
 
 #define ENABLE_VULKAN_FUNCTION_RESULT_VALIDATION 1
 
+/* Cubic chunks (16x16x16 chunks streamed in all directions instead of 16x256x16 columns) */
+#define ENABLE_CUBIC_CHUNKS 0
+
+/* Greedy meshing (merge adjacent coplanar opaque faces with same texture into larger quads) */
+#define ENABLE_GREEDY_MESHING 0
+
+/* Vertex pulling (face is one packed 32-bit record in storage buffer, vertex shader expands it to quad) */
+#define ENABLE_VERTEX_PULLING 0
+
 #define GLM_FORCE_RADIANS
 #define GLM_FORCE_DEPTH_ZERO_TO_ONE
 #define GLM_FORCE_LEFT_HANDED
@@ -33,6 +44,7 @@ typedef uint64_t UINT64;
 #include "ext/glm/glm/glm.hpp"
 #include "ext/glm/glm/ext/matrix_clip_space.hpp"
 #include "ext/glm/glm/ext/matrix_transform.hpp"
+#include "ext/glm/glm/gtc/type_precision.hpp"
 #include "ext/glm/glm/gtx/euler_angles.hpp"
 
 #endif /* __def_h_ */
@@ -1 +1,93 @@
+#include <stdexcept>
+
 #include "block.h"
+
+/** Face normals */
+const std::array<glm::ivec3, BLOCK::NumberOfFaces> BLOCK::FaceNormals =
+{
+  glm::ivec3(-1, 0, 0),
+  glm::ivec3(1, 0, 0),
+  glm::ivec3(0, -1, 0),
+  glm::ivec3(0, 1, 0),
+  glm::ivec3(0, 0, -1),
+  glm::ivec3(0, 0, 1)
+};
+
+/** Orientations table */
+const std::array<BLOCK::AXES, BLOCK::NumberOfOrientations> BLOCK::Orientations = BLOCK::BuildOrientations();
+
+/**
+ * \brief Build orientations table function
+ * \return Orientations table
+ */
+std::array<BLOCK::AXES, BLOCK::NumberOfOrientations> BLOCK::BuildOrientations( VOID )
+{
+  const glm::ivec3 Axes[6] =
+  {
+    glm::ivec3(1, 0, 0), glm::ivec3(-1, 0, 0),
+    glm::ivec3(0, 1, 0), glm::ivec3(0, -1, 0),
+    glm::ivec3(0, 0, 1), glm::ivec3(0, 0, -1)
+  };
+
+  std::array<AXES, NumberOfOrientations> Result;
+  UINT32 Count = 0;
+
+  for (const glm::ivec3 &Direction : Axes)
+    for (const glm::ivec3 &Up : Axes)
+      if (glm::dot(glm::vec3(Direction), glm::vec3(Up)) == 0)
+        Result[Count++] = {Direction, glm::ivec3(glm::cross(glm::vec3(Direction), glm::vec3(Up))), Up};
+
+  return Result;
+}
+
+/**
+ * \brief Get block direction function
+ * \return Block direction
+ */
+glm::ivec3 BLOCK::GetDirection( VOID ) const
+{
+  return Orientations[Orientation].Direction;
+}
+
+/**
+ * \brief Get block right direction function
+ * \return Block right direction
+ */
+glm::ivec3 BLOCK::GetRight( VOID ) const
+{
+  return Orientations[Orientation].Right;
+}
+
+/**
+ * \brief Get block up direction function
+ * \return Block up direction
+ */
+glm::ivec3 BLOCK::GetUp( VOID ) const
+{
+  return Orientations[Orientation].Up;
+}
+
+/**
+ * \brief Get orientation by axes function
+ * \param[in] Direction Block direction (axis-aligned unit vector)
+ * \param[in] Up Block up direction (axis-aligned unit vector, orthogonal to direction)
+ * \return Orientation index
+ */
+BYTE BLOCK::GetOrientation( const glm::ivec3 &Direction, const glm::ivec3 &Up )
+{
+  for (UINT32 i = 0; i < NumberOfOrientations; i++)
+    if (Orientations[i].Direction == Direction && Orientations[i].Up == Up)
+      return i;
+
+  throw std::runtime_error("invalid block orientation");
+}
+
+/**
+ * \brief Compare block states function
+ * \param[in] Other Block for compare
+ * \return TRUE-if states are equal, FALSE-if otherwise
+ */
+BOOL BLOCK::operator==( const BLOCK &Other ) const
+{
+  return BlockTypeId == Other.BlockTypeId && Orientation == Other.Orientation;
+}
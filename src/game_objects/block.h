@@ -1,6 +1,8 @@
 #ifndef __block_h_
 #define __block_h_
 
+#include <array>
+
 #include "def.h"
 
 /**
@@ -8,17 +10,85 @@
  */
 struct BLOCK
 {
+  /** Number of block orientations (cube rotations) */
+  static constexpr UINT32 NumberOfOrientations = 24;
+
+  /** Number of block faces */
+  static constexpr UINT32 NumberOfFaces = 6;
+
+  /** Face indices (by face normal) */
+  static constexpr UINT32
+    FaceLeft = 0,  // -X
+    FaceRight = 1, // +X
+    FaceDown = 2,  // -Y
+    FaceUp = 3,    // +Y
+    FaceBack = 4,  // -Z
+    FaceFront = 5; // +Z
+
+  /** Face normals */
+  static const std::array<glm::ivec3, NumberOfFaces> FaceNormals;
+
   /** Block type identifier */
   UINT32 BlockTypeId = 0;
 
-  /** Block direction */
-  glm::ivec3 Direction = glm::ivec3(1, 0, 0);
+  /** Block orientation (index in orientations table, 0-direction +X, right +Z, up +Y) */
+  BYTE Orientation = 0;
+
+  /**
+   * \brief Get block direction function
+   * \return Block direction
+   */
+  glm::ivec3 GetDirection( VOID ) const;
+
+  /**
+   * \brief Get block right direction function
+   * \return Block right direction
+   */
+  glm::ivec3 GetRight( VOID ) const;
+
+  /**
+   * \brief Get block up direction function
+   * \return Block up direction
+   */
+  glm::ivec3 GetUp( VOID ) const;
+
+  /**
+   * \brief Get orientation by axes function
+   * \param[in] Direction Block direction (axis-aligned unit vector)
+   * \param[in] Up Block up direction (axis-aligned unit vector, orthogonal to direction)
+   * \return Orientation index
+   */
+  static BYTE GetOrientation( const glm::ivec3 &Direction, const glm::ivec3 &Up );
+
+  /**
+   * \brief Compare block states function
+   * \param[in] Other Block for compare
+   * \return TRUE-if states are equal, FALSE-if otherwise
+   */
+  BOOL operator==( const BLOCK &Other ) const;
+
+private:
+  /** Orientation axes description */
+  struct AXES
+  {
+    /** Block direction */
+    glm::ivec3 Direction;
+
+    /** Block right direction */
+    glm::ivec3 Right;
+
+    /** Block up direction */
+    glm::ivec3 Up;
+  };
 
-  /** Block right direction */
-  glm::ivec3 Right = glm::ivec3(0, 0, 1);
+  /**
+   * \brief Build orientations table function
+   * \return Orientations table
+   */
+  static std::array<AXES, NumberOfOrientations> BuildOrientations( VOID );
 
-  /** Block up direction */
-  glm::ivec3 Up = glm::ivec3(0, 1, 0);
+  /** Orientations table */
+  static const std::array<AXES, NumberOfOrientations> Orientations;
 };
 
 #endif /* __block_h_ */
@@ -0,0 +1,225 @@
+#include <stdexcept>
+#include <cstring>
+
+#include "block_storage.h"
+#include "block_type.h"
+
+/**
+ * \brief Blocks storage constructor
+ * \param[in] NumberOfBlocks Number of blocks in storage
+ * \param[in] Fill Initial state of all blocks
+ */
+block_storage::block_storage( UINT32 NumberOfBlocks, const BLOCK &Fill ) :
+  NumberOfBlocks(NumberOfBlocks), Palette(1, Fill), Data(((UINT64)NumberOfBlocks + 63) / 64, 0)
+{
+}
+
+/**
+ * \brief Set block function
+ * \param[in] Index Block index
+ * \param[in] Block New block state
+ */
+VOID block_storage::Set( UINT32 Index, const BLOCK &Block )
+{
+  UINT64 PaletteIndex = GetPaletteIndex(Block);
+  UINT64 BitOffset = (UINT64)Index * BitsPerBlock;
+  UINT64 &Word = Data[BitOffset >> 6];
+
+  Word &= ~(IndexMask << (BitOffset & 63));
+  Word |= PaletteIndex << (BitOffset & 63);
+}
+
+/**
+ * \brief Find block state in palette or add it function
+ * \param[in] Block Block state
+ * \return Palette index
+ */
+UINT32 block_storage::GetPaletteIndex( const BLOCK &Block )
+{
+  for (UINT32 i = 0; i < Palette.size(); i++)
+    if (Palette[i] == Block)
+      return i;
+
+  if (Palette.size() == (1ull << BitsPerBlock))
+  {
+    if (BitsPerBlock == MaxBitsPerBlock)
+      throw std::runtime_error("block palette overflow");
+
+    Resize(BitsPerBlock * 2);
+  }
+
+  Palette.push_back(Block);
+
+  return Palette.size() - 1;
+}
+
+/**
+ * \brief Repack indices with new number of bits per block function
+ * \param[in] NewBitsPerBlock New number of bits per block
+ */
+VOID block_storage::Resize( UINT32 NewBitsPerBlock )
+{
+  std::vector<UINT64> NewData(((UINT64)NumberOfBlocks * NewBitsPerBlock + 63) / 64, 0);
+
+  for (UINT64 i = 0; i < NumberOfBlocks; i++)
+  {
+    UINT64 BitOffset = i * BitsPerBlock;
+    UINT64 PaletteIndex = (Data[BitOffset >> 6] >> (BitOffset & 63)) & IndexMask;
+    UINT64 NewBitOffset = i * NewBitsPerBlock;
+
+    NewData[NewBitOffset >> 6] |= PaletteIndex << (NewBitOffset & 63);
+  }
+
+  Data = std::move(NewData);
+  BitsPerBlock = NewBitsPerBlock;
+  IndexMask = (1ull << NewBitsPerBlock) - 1;
+}
+
+/**
+ * \brief Get number of blocks function
+ * \return Number of blocks in storage
+ */
+UINT32 block_storage::GetNumberOfBlocks( VOID ) const
+{
+  return NumberOfBlocks;
+}
+
+/**
+ * \brief Get number of bits per block function
+ * \return Number of bits per block
+ */
+UINT32 block_storage::GetBitsPerBlock( VOID ) const
+{
+  return BitsPerBlock;
+}
+
+/**
+ * \brief Get palette size function
+ * \return Number of distinct block states in palette
+ */
+UINT32 block_storage::GetPaletteSize( VOID ) const
+{
+  return Palette.size();
+}
+
+/**
+ * \brief Get used memory function
+ * \return Size of used memory in bytes
+ */
+UINT64 block_storage::GetMemoryUsage( VOID ) const
+{
+  return sizeof(block_storage) + Palette.capacity() * sizeof(BLOCK) + Data.capacity() * sizeof(UINT64);
+}
+
+/**
+ * \brief Save storage to bytes array function
+ * \param[in, out] Bytes Array for appending serialized data
+ */
+VOID block_storage::Save( std::vector<BYTE> &Bytes ) const
+{
+  UINT32 Header[3] = {NumberOfBlocks, BitsPerBlock, (UINT32)Palette.size()};
+  UINT64 Offset = Bytes.size();
+
+  Bytes.resize(Offset + sizeof(Header) + Palette.size() * SavedBlockSize + Data.size() * sizeof(UINT64));
+
+  memcpy(Bytes.data() + Offset, Header, sizeof(Header));
+  Offset += sizeof(Header);
+
+  for (const BLOCK &Block : Palette)
+  {
+    SaveBlock(Block, Bytes.data() + Offset);
+    Offset += SavedBlockSize;
+  }
+
+  memcpy(Bytes.data() + Offset, Data.data(), Data.size() * sizeof(UINT64));
+}
+
+/**
+ * \brief Load storage from bytes array function
+ * \param[in] Bytes Serialized data
+ * \param[in] Size Serialized data size
+ * \return Number of read bytes
+ */
+UINT64 block_storage::Load( const BYTE *Bytes, UINT64 Size )
+{
+  UINT32 Header[3] = {};
+
+  if (Size < sizeof(Header))
+    throw std::runtime_error("blocks storage data corrupted");
+
+  memcpy(Header, Bytes, sizeof(Header));
+
+  UINT32 NewNumberOfBlocks = Header[0];
+  UINT32 NewBitsPerBlock = Header[1];
+  UINT32 PaletteSize = Header[2];
+
+  if (NewNumberOfBlocks != NumberOfBlocks || NewBitsPerBlock == 0 || NewBitsPerBlock > MaxBitsPerBlock ||
+      (NewBitsPerBlock & (NewBitsPerBlock - 1)) != 0 || PaletteSize == 0 || PaletteSize > (1ull << NewBitsPerBlock))
+    throw std::runtime_error("blocks storage data corrupted");
+
+  UINT64 DataSize = ((UINT64)NumberOfBlocks * NewBitsPerBlock + 63) / 64;
+  UINT64 ReadSize = sizeof(Header) + (UINT64)PaletteSize * SavedBlockSize + DataSize * sizeof(UINT64);
+
+  if (Size < ReadSize)
+    throw std::runtime_error("blocks storage data corrupted");
+
+  std::vector<BLOCK> NewPalette(PaletteSize);
+  std::vector<UINT64> NewData(DataSize);
+  const BYTE *ReadBlock = Bytes + sizeof(Header);
+
+  for (BLOCK &Block : NewPalette)
+  {
+    Block = LoadBlock(ReadBlock);
+    ReadBlock += SavedBlockSize;
+  }
+
+  memcpy(NewData.data(), ReadBlock, DataSize * sizeof(UINT64));
+
+  UINT64 NewIndexMask = (1ull << NewBitsPerBlock) - 1;
+
+  /* Indices past palette end are possible only in corrupted data */
+  if (PaletteSize < (1ull << NewBitsPerBlock))
+    for (UINT64 i = 0; i < NumberOfBlocks; i++)
+    {
+      UINT64 BitOffset = i * NewBitsPerBlock;
+
+      if (((NewData[BitOffset >> 6] >> (BitOffset & 63)) & NewIndexMask) >= PaletteSize)
+        throw std::runtime_error("blocks storage data corrupted");
+    }
+
+  Palette = std::move(NewPalette);
+  Data = std::move(NewData);
+  BitsPerBlock = NewBitsPerBlock;
+  IndexMask = NewIndexMask;
+
+  return ReadSize;
+}
+
+/**
+ * \brief Save block state function
+ * \param[in] Block Block state
+ * \param[out] Bytes Memory for SavedBlockSize bytes
+ */
+VOID block_storage::SaveBlock( const BLOCK &Block, BYTE *Bytes )
+{
+  memcpy(Bytes, &Block.BlockTypeId, sizeof(UINT32));
+  Bytes[sizeof(UINT32)] = Block.Orientation;
+}
+
+/**
+ * \brief Load block state function (throws if block type or orientation doesn't exist)
+ * \param[in] Bytes Memory with SavedBlockSize bytes
+ * \return Block state
+ */
+BLOCK block_storage::LoadBlock( const BYTE *Bytes )
+{
+  BLOCK Block;
+
+  memcpy(&Block.BlockTypeId, Bytes, sizeof(UINT32));
+  Block.Orientation = Bytes[sizeof(UINT32)];
+
+  if (Block.BlockTypeId >= BLOCK_TYPE::Table.size() || Block.Orientation >= BLOCK::NumberOfOrientations)
+    throw std::runtime_error("blocks storage data corrupted");
+
+  return Block;
+}
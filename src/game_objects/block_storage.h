@@ -0,0 +1,133 @@
+#ifndef __block_storage_h_
+#define __block_storage_h_
+
+#include <vector>
+
+#include "def.h"
+#include "block.h"
+
+/**
+ * \brief Palette-compressed blocks storage
+ *
+ * Every block is stored as index in palette of distinct block states.
+ * Indices are bit-packed in 64-bit words with 1, 2, 4, 8 or 16 bits per block,
+ * width grows when palette overflows.
+ */
+class block_storage
+{
+public:
+  /** Maximal number of bits per block */
+  static constexpr UINT32 MaxBitsPerBlock = 16;
+
+  /** Size of saved block state in bytes (type identifier and orientation without structure padding) */
+  static constexpr UINT32 SavedBlockSize = sizeof(UINT32) + sizeof(BYTE);
+
+  /**
+   * \brief Blocks storage constructor
+   * \param[in] NumberOfBlocks Number of blocks in storage
+   * \param[in] Fill Initial state of all blocks
+   */
+  block_storage( UINT32 NumberOfBlocks, const BLOCK &Fill = BLOCK() );
+
+  /**
+   * \brief Get block function
+   * \param[in] Index Block index
+   * \return Reference to block state (valid until next Set call)
+   */
+  const BLOCK & Get( UINT32 Index ) const
+  {
+    UINT64 BitOffset = (UINT64)Index * BitsPerBlock;
+
+    return Palette[(Data[BitOffset >> 6] >> (BitOffset & 63)) & IndexMask];
+  }
+
+  /**
+   * \brief Set block function
+   * \param[in] Index Block index
+   * \param[in] Block New block state
+   */
+  VOID Set( UINT32 Index, const BLOCK &Block );
+
+  /**
+   * \brief Get number of blocks function
+   * \return Number of blocks in storage
+   */
+  UINT32 GetNumberOfBlocks( VOID ) const;
+
+  /**
+   * \brief Get number of bits per block function
+   * \return Number of bits per block
+   */
+  UINT32 GetBitsPerBlock( VOID ) const;
+
+  /**
+   * \brief Get palette size function
+   * \return Number of distinct block states in palette
+   */
+  UINT32 GetPaletteSize( VOID ) const;
+
+  /**
+   * \brief Get used memory function
+   * \return Size of used memory in bytes
+   */
+  UINT64 GetMemoryUsage( VOID ) const;
+
+  /**
+   * \brief Save storage to bytes array function
+   * \param[in, out] Bytes Array for appending serialized data
+   */
+  VOID Save( std::vector<BYTE> &Bytes ) const;
+
+  /**
+   * \brief Load storage from bytes array function
+   * \param[in] Bytes Serialized data
+   * \param[in] Size Serialized data size
+   * \return Number of read bytes
+   */
+  UINT64 Load( const BYTE *Bytes, UINT64 Size );
+
+  /**
+   * \brief Save block state function
+   * \param[in] Block Block state
+   * \param[out] Bytes Memory for SavedBlockSize bytes
+   */
+  static VOID SaveBlock( const BLOCK &Block, BYTE *Bytes );
+
+  /**
+   * \brief Load block state function (throws if block type or orientation doesn't exist)
+   * \param[in] Bytes Memory with SavedBlockSize bytes
+   * \return Block state
+   */
+  static BLOCK LoadBlock( const BYTE *Bytes );
+
+private:
+  /**
+   * \brief Find block state in palette or add it function
+   * \param[in] Block Block state
+   * \return Palette index
+   */
+  UINT32 GetPaletteIndex( const BLOCK &Block );
+
+  /**
+   * \brief Repack indices with new number of bits per block function
+   * \param[in] NewBitsPerBlock New number of bits per block
+   */
+  VOID Resize( UINT32 NewBitsPerBlock );
+
+  /** Number of blocks */
+  UINT32 NumberOfBlocks;
+
+  /** Number of bits per block */
+  UINT32 BitsPerBlock = 1;
+
+  /** Mask for palette index */
+  UINT64 IndexMask = 1;
+
+  /** Palette with distinct block states */
+  std::vector<BLOCK> Palette;
+
+  /** Bit-packed palette indices */
+  std::vector<UINT64> Data;
+};
+
+#endif /* __block_storage_h_ */
@@ -33,3 +33,48 @@ std::vector<BLOCK_TYPE> BLOCK_TYPE::Table =
   BLOCK_TYPE(1),    // Grass
   BLOCK_TYPE(0.99), // Glass
 };
+
+/** Texture coordinates in texture tile for every texture index */
+std::vector<std::array<glm::vec2, 4>> BLOCK_TYPE::TexCoords;
+
+/** Texture tile rectangles in atlas for every texture index */
+std::vector<glm::vec4> BLOCK_TYPE::TexRects;
+
+/** Texture indices for every block state (type and orientation) and face */
+std::vector<UINT32> BLOCK_TYPE::FaceTextures;
+
+/**
+ * \brief Build face to texture table function (must be called after filling textures)
+ */
+VOID BLOCK_TYPE::BuildFaceTextures( VOID )
+{
+  FaceTextures.resize(Table.size() * BLOCK::NumberOfOrientations * BLOCK::NumberOfFaces);
+
+  for (UINT32 TypeId = 0; TypeId < Table.size(); TypeId++)
+    for (UINT32 Orientation = 0; Orientation < BLOCK::NumberOfOrientations; Orientation++)
+    {
+      BLOCK Block;
+
+      Block.BlockTypeId = TypeId;
+      Block.Orientation = Orientation;
+
+      for (UINT32 Face = 0; Face < BLOCK::NumberOfFaces; Face++)
+      {
+        glm::vec3 Normal(BLOCK::FaceNormals[Face]);
+        FLT DirectionProjection = glm::dot(glm::vec3(Block.GetDirection()), Normal);
+        FLT RightProjection = glm::dot(glm::vec3(Block.GetRight()), Normal);
+        FLT UpProjection = glm::dot(glm::vec3(Block.GetUp()), Normal);
+        UINT32 Side = SideUp;
+
+        if (DirectionProjection != 0)
+          Side = DirectionProjection > 0 ? SideFront : SideBack;
+        else if (RightProjection != 0)
+          Side = RightProjection > 0 ? SideRight : SideLeft;
+        else
+          Side = UpProjection > 0 ? SideUp : SideDown;
+
+        FaceTextures[(TypeId * BLOCK::NumberOfOrientations + Orientation) * BLOCK::NumberOfFaces + Face] =
+          Table[TypeId].Textures[Side];
+      }
+    }
+}
@@ -2,44 +2,91 @@
 #define __block_type_h_
 
 #include <vector>
+#include <array>
 
 #include "def.h"
+#include "block.h"
 
 /**
  * \brief Struct with block type description
  */
 struct BLOCK_TYPE
 {
+  /** Number of block sides (in block space) */
+  static constexpr UINT32 NumberOfSides = 6;
+
+  /** Side indices */
+  static constexpr UINT32
+    SideUp = 0,
+    SideRight = 1,
+    SideLeft = 2,
+    SideDown = 3,
+    SideFront = 4,
+    SideBack = 5;
+
   /** Block transparency */
   FLT Alpha = 1;
 
-  /** Up texture coords */
-  glm::vec2 TexCoordUp[4];
-
-  /** Right texture coords */
-  glm::vec2 TexCoordRight[4];
+  /** Texture indices for every side */
+  UINT32 Textures[NumberOfSides] = {};
 
-  /** Left texture coords */
-  glm::vec2 TexCoordLeft[4];
+  /**
+   * \brief Block type constructor
+   * \param Alpha Block transparency
+   */
+  BLOCK_TYPE( FLT Alpha );
 
-  /** Down texture coords */
-  glm::vec2 TexCoordDown[4];
+  /**
+   * \brief Build face to texture table function (must be called after filling textures)
+   */
+  static VOID BuildFaceTextures( VOID );
 
-  /** Front texture coords */
-  glm::vec2 TexCoordFront[4];
+  /**
+   * \brief Get texture index for block face function
+   * \param[in] Block Block state
+   * \param[in] Face Face index (in world space)
+   * \return Texture index
+   */
+  static UINT32 GetFaceTexture( const BLOCK &Block, UINT32 Face )
+  {
+    return FaceTextures[(Block.BlockTypeId * BLOCK::NumberOfOrientations + Block.Orientation) *
+                        BLOCK::NumberOfFaces + Face];
+  }
 
-  /** Back texture coords */
-  glm::vec2 TexCoordBack[4];
+  /**
+   * \brief Get texture coordinates for block face function
+   * \param[in] Block Block state
+   * \param[in] Face Face index (in world space)
+   * \return Pointer to 4 texture coordinates (in texture tile, 0 or 1)
+   */
+  static const glm::vec2 * GetFaceTexCoords( const BLOCK &Block, UINT32 Face )
+  {
+    return TexCoords[GetFaceTexture(Block, Face)].data();
+  }
 
   /**
-   * \brief Block type constructor
-   * \param Alpha Block transparency
+   * \brief Get texture tile rectangle for block face function
+   * \param[in] Block Block state
+   * \param[in] Face Face index (in world space)
+   * \return Texture tile rectangle in atlas (offset in xy, size in zw)
    */
-  BLOCK_TYPE( FLT Alpha );
+  static const glm::vec4 & GetFaceTexRect( const BLOCK &Block, UINT32 Face )
+  {
+    return TexRects[GetFaceTexture(Block, Face)];
+  }
 
   /** Block types table */
   static std::vector<BLOCK_TYPE> Table;
 
+  /** Texture coordinates in texture tile for every texture index */
+  static std::vector<std::array<glm::vec2, 4>> TexCoords;
+
+  /** Texture tile rectangles in atlas for every texture index */
+  static std::vector<glm::vec4> TexRects;
+
+  /** Texture indices for every block state (type and orientation) and face */
+  static std::vector<UINT32> FaceTextures;
+
   /** Stone type identifier */
   static const UINT32 StoneId;
 
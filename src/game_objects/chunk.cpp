@@ -1,94 +1,122 @@
+#include <algorithm>
+
 #include "chunk.h"
 #include "utils/aabb.h"
 #include "block_type.h"
 
 /**
- * \brief Create geometry for chunk
- * \param[in, out] Render Reference to render
- * \param[in] ChunkPos Chunk position
+ * \brief Chunk constructor (chunk is filled with air)
  */
-VOID chunk::CreateGeometry( render &Render, const std::pair<INT32, INT32> &ChunkPos )
+chunk::chunk( VOID ) : Blocks(new chunk_blocks())
 {
-  Geometry = std::make_unique<chunk_geometry>(Render, Blocks.data(), ChunkPos);
 }
 
 /**
- * \brief Destroy geometry for chunk
+ * \brief Chunk destructor
  */
-VOID chunk::DestroyGeometry( VOID )
+chunk::~chunk( VOID )
 {
-  Geometry = nullptr;
+  delete Blocks.load();
 }
 
 /**
- * \brief Update block function
- * \param BlockPos Block position
+ * \brief Get chunk blocks function (published blocks are never changed, edits replace them)
+ * \return Reference to chunk blocks (valid under active chunks mutex or until epoch guard leaves epoch)
  */
-VOID chunk::UpdateBlock( const glm::ivec3 &BlockPos )
+const chunk_blocks & chunk::GetBlocks( VOID ) const
 {
-  Geometry->UpdateBlock(BlockPos, Blocks.data());
+  return *Blocks.load();
 }
 
 /**
- * \brief Update command buffer function
+ * \brief Publish new chunk blocks function (active chunks mutex must be locked)
+ * \param[in] NewBlocks New chunk blocks
+ * \return Old chunk blocks (lock-free readers may still use them)
  */
-VOID chunk::UpdateCommandBuffer( VOID ) const
+std::unique_ptr<chunk_blocks> chunk::SetBlocks( std::unique_ptr<chunk_blocks> NewBlocks )
 {
-  Geometry->UpdateCommandBuffer();
+  return std::unique_ptr<chunk_blocks>(Blocks.exchange(NewBlocks.release()));
 }
 
 /**
- * \brief Update up block border
- * \param[in] BlockPos Block position
+ * \brief Set chunk geometry function (new geometry replaces old one between frames)
+ * \param[in, out] Render Reference to render
+ * \param[in] NewGeometry New geometry (nullptr - remove geometry)
  */
-VOID chunk::UpdateUpSide( const glm::ivec3 &BlockPos )
+VOID chunk::SetGeometry( render &Render, std::unique_ptr<chunk_geometry> NewGeometry )
 {
-  Geometry->UpdateUpSide(BlockPos, Blocks.data());
-}
+  if (Geometry == nullptr && NewGeometry == nullptr)
+    return;
 
-/**
- * \brief Update left block border
- * \param[in] BlockPos Block position
- */
-VOID chunk::UpdateLeftSide( const glm::ivec3 &BlockPos )
-{
-  Geometry->UpdateLeftSide(BlockPos, Blocks.data());
-}
+  Render.ReplaceDrawElement(Geometry.get(), NewGeometry.get());
 
-/**
- * \brief Update down block border
- * \param[in] BlockPos Block position
- */
-VOID chunk::UpdateDownSide( const glm::ivec3 &BlockPos )
-{
-  Geometry->UpdateDownSide(BlockPos, Blocks.data());
+  /* Old geometry isn't used by any frame after swap */
+  Geometry = std::move(NewGeometry);
 }
 
 /**
- * \brief Update right block border
- * \param[in] BlockPos Block position
+ * \brief Mark sections with rows as dirty function
+ * \param[in] MinY Minimal row Y-coordinate (clamped to chunk)
+ * \param[in] MaxY Maximal row Y-coordinate (clamped to chunk)
  */
-VOID chunk::UpdateRightSide( const glm::ivec3 &BlockPos )
+VOID chunk::MarkRowsDirty( INT32 MinY, INT32 MaxY )
 {
-  Geometry->UpdateRightSide(BlockPos, Blocks.data());
+  MinY = std::max(MinY, 0);
+  MaxY = std::min(MaxY, ChunkSizeY - 1);
+
+  for (INT32 SectionId = MinY / chunk_blocks::SectionSize; SectionId <= MaxY / chunk_blocks::SectionSize; SectionId++)
+    DirtySections |= 1u << SectionId;
 }
 
 /**
- * \brief Update front block border
- * \param[in] BlockPos Block position
+ * \brief Set neighbour border and mark sections of changed border cells as dirty function
+ * \param[in] Face Direction to neighbour (BLOCK::Face* constant)
+ * \param[in] Border Neighbour border opacity bits (empty - neighbour isn't loaded)
+ * \return TRUE-if any section became dirty, FALSE-if otherwise
  */
-VOID chunk::UpdateFrontSide( const glm::ivec3 &BlockPos )
+BOOL chunk::SetBorder( UINT32 Face, std::vector<UINT64> Border )
 {
-  Geometry->UpdateFrontSide(BlockPos, Blocks.data());
+  std::vector<UINT64> &OldBorder = Borders.Opaque[Face];
+  std::vector<UINT64> Changed(std::max(OldBorder.size(), Border.size()), 0);
+
+  for (UINT64 i = 0; i < Changed.size(); i++)
+    Changed[i] = (i < OldBorder.size() ? OldBorder[i] : 0) ^ (i < Border.size() ? Border[i] : 0);
+
+  OldBorder = std::move(Border);
+
+  UINT32 OldDirtySections = DirtySections;
+
+  for (UINT64 i = 0; i < Changed.size(); i++)
+    for (UINT64 Bits = Changed[i]; Bits != 0; Bits &= Bits - 1)
+    {
+      glm::ivec3 BlockPos = chunk_mesher::GetBorderPos(i * 64 + chunk_mesher::GetLowestBit(Bits), Face);
+
+      /* Air block has no faces with any neighbour */
+      if (!GetBlocks().IsAir(chunk_mesher::GetIndex(BlockPos)))
+        MarkRowsDirty(BlockPos.y, BlockPos.y);
+    }
+
+  return DirtySections != OldDirtySections;
 }
 
 /**
- * \brief Update back block border
- * \param[in] BlockPos Block position
+ * \brief Set opacity of one neighbour block in border function
+ * \param[in] Face Direction to neighbour (BLOCK::Face* constant)
+ * \param[in] BlockPos Chunk block adjacent to neighbour block
+ * \param[in] IsOpaque Neighbour block is opaque flag
  */
-VOID chunk::UpdateBackSide( const glm::ivec3 &BlockPos )
+VOID chunk::SetBorderCell( UINT32 Face, const glm::ivec3 &BlockPos, BOOL IsOpaque )
 {
-  Geometry->UpdateBackSide(BlockPos, Blocks.data());
+  std::vector<UINT64> &Border = Borders.Opaque[Face];
+  UINT32 Cell = chunk_mesher::GetBorderCell(BlockPos, Face);
+
+  if (Border.empty())
+    return;
+
+  if (IsOpaque)
+    Border[Cell / 64] |= 1ull << (Cell % 64);
+  else
+    Border[Cell / 64] &= ~(1ull << (Cell % 64));
 }
 
 /**
@@ -102,13 +130,13 @@ VOID chunk::UpdateBackSide( const glm::ivec3 &BlockPos )
  * \return Block coordinates
  */
 glm::ivec3 chunk::GetSelectedBlock( const glm::vec3 &Pos, const glm::vec3 &Dir, INT MaxDistance, FLT *T,
-                                    const std::pair<INT32, INT32> &ChunkPos, glm::ivec3 &Normal ) const
+                                    const CHUNK_POS &ChunkPos, glm::ivec3 &Normal ) const
 {
   *T = std::numeric_limits<FLT>::max();
   glm::ivec3 Result(0, 0, 0);
 
-  glm::vec3 RelativePos = glm::vec3(Pos.x - ChunkPos.first * ChunkSizeX, Pos.y,
-                                    Pos.z - ChunkPos.second * ChunkSizeX);
+  glm::vec3 RelativePos = glm::vec3(Pos.x - ChunkPos.X * ChunkSizeX, Pos.y - ChunkPos.Y * ChunkSizeY,
+                                    Pos.z - ChunkPos.Z * ChunkSizeZ);
 
   ray Ray(RelativePos, Dir);
 
@@ -139,12 +167,21 @@ glm::ivec3 chunk::GetSelectedBlock( const glm::vec3 &Pos, const glm::vec3 &Dir,
   else
     MaxZ = std::min(CenterZ, (INT64)ChunkSizeZ - 1);
 
+  /* Blocks are loaded once - edit can publish new ones while ray is cast */
+  const chunk_blocks &CurBlocks = GetBlocks();
+
+  MinY = std::max(MinY, (INT64)CurBlocks.GetMinY());
+  MaxY = std::min(MaxY, (INT64)CurBlocks.GetMaxY());
+
   for (INT64 z = MinZ; z <= MaxZ; z++)
     for (INT64 y = MinY; y <= MaxY; y++)
+    {
+      if (CurBlocks.IsSectionEmpty(y / chunk_blocks::SectionSize) || CurBlocks.GetNotAirRow(y, z) == 0)
+        continue;
+
       for (INT64 x = MinX; x <= MaxX; x++)
       {
-        if (Blocks[z * (UINT64)ChunkSizeY * ChunkSizeX +
-            y * (UINT64)ChunkSizeX + x].BlockTypeId != BLOCK_TYPE::AirId)
+        if (!CurBlocks.IsAir(z * (UINT64)ChunkSizeY * ChunkSizeX + y * (UINT64)ChunkSizeX + x))
         {
           aabb Box(glm::vec3(x, y, z), glm::vec3(x + 1, y + 1, z + 1));
           FLT NewT = std::numeric_limits<FLT>::max();
@@ -174,6 +211,7 @@ glm::ivec3 chunk::GetSelectedBlock( const glm::vec3 &Pos, const glm::vec3 &Dir,
           }
         }
       }
+    }
 
   return Result;
 }
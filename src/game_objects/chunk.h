@@ -3,10 +3,14 @@
 
 #include <memory>
 #include <array>
+#include <atomic>
 
 #include "def.h"
 #include "block.h"
+#include "chunk_pos.h"
+#include "chunk_blocks.h"
 #include "render/chunk_geometry.h"
+#include "render/chunk_mesher.h"
 #include "render/render.h"
 
 /**
@@ -19,22 +23,45 @@ public:
   static constexpr INT ChunkSizeX = 16;
 
   /** Chunk size for Y-coordinate */
-  static constexpr INT ChunkSizeY = 256;
+  static constexpr INT ChunkSizeY = ENABLE_CUBIC_CHUNKS ? 16 : 256;
 
   /** Chunk size for Z-coordinate */
   static constexpr INT ChunkSizeZ = 16;
 
+  static_assert(chunk_blocks::ChunkSizeX == ChunkSizeX);
+  static_assert(chunk_blocks::ChunkSizeY == ChunkSizeY);
+  static_assert(chunk_blocks::ChunkSizeZ == ChunkSizeZ);
+  static_assert(chunk_blocks::NumberOfSections <= 32, "dirty sections mask is 32-bit");
+
   /**
-   * \brief Create geometry for chunk
-   * \param[in, out] Render Reference to render
-   * \param[in] ChunkPos Chunk position
+   * \brief Chunk constructor (chunk is filled with air)
+   */
+  chunk( VOID );
+
+  /**
+   * \brief Chunk destructor
+   */
+  ~chunk( VOID );
+
+  /**
+   * \brief Get chunk blocks function (published blocks are never changed, edits replace them)
+   * \return Reference to chunk blocks (valid under active chunks mutex or until epoch guard leaves epoch)
    */
-  VOID CreateGeometry( render &Render, const std::pair<INT32, INT32> &ChunkPos );
+  const chunk_blocks & GetBlocks( VOID ) const;
 
   /**
-   * \brief Destroy geometry for chunk
+   * \brief Publish new chunk blocks function (active chunks mutex must be locked)
+   * \param[in] NewBlocks New chunk blocks
+   * \return Old chunk blocks (lock-free readers may still use them)
    */
-  VOID DestroyGeometry( VOID );
+  std::unique_ptr<chunk_blocks> SetBlocks( std::unique_ptr<chunk_blocks> NewBlocks );
+
+  /**
+   * \brief Set chunk geometry function (new geometry replaces old one between frames)
+   * \param[in, out] Render Reference to render
+   * \param[in] NewGeometry New geometry (nullptr - remove geometry)
+   */
+  VOID SetGeometry( render &Render, std::unique_ptr<chunk_geometry> NewGeometry );
 
   /**
    * \brief Get selected block function
@@ -47,59 +74,62 @@ public:
    * \return Block coordinates
    */
   glm::ivec3 GetSelectedBlock( const glm::vec3 &Pos, const glm::vec3 &Dir, INT MaxDistance, FLT *T,
-                               const std::pair<INT32, INT32> &ChunkPos, glm::ivec3 &Normal ) const;
+                               const CHUNK_POS &ChunkPos, glm::ivec3 &Normal ) const;
 
   /**
-   * \brief Update block function
-   * \param[in] BlockPos Block position
+   * \brief Mark sections with rows as dirty function
+   * \param[in] MinY Minimal row Y-coordinate (clamped to chunk)
+   * \param[in] MaxY Maximal row Y-coordinate (clamped to chunk)
    */
-  VOID UpdateBlock( const glm::ivec3 &BlockPos );
+  VOID MarkRowsDirty( INT32 MinY, INT32 MaxY );
 
   /**
-   * \brief Update up block border
-   * \param[in] BlockPos Block position
+   * \brief Set neighbour border and mark sections of changed border cells as dirty function
+   * \param[in] Face Direction to neighbour (BLOCK::Face* constant)
+   * \param[in] Border Neighbour border opacity bits (empty - neighbour isn't loaded)
+   * \return TRUE-if any section became dirty, FALSE-if otherwise
    */
-  VOID UpdateUpSide( const glm::ivec3 &BlockPos );
+  BOOL SetBorder( UINT32 Face, std::vector<UINT64> Border );
 
   /**
-   * \brief Update left block border
-   * \param[in] BlockPos Block position
+   * \brief Set opacity of one neighbour block in border function
+   * \param[in] Face Direction to neighbour (BLOCK::Face* constant)
+   * \param[in] BlockPos Chunk block adjacent to neighbour block
+   * \param[in] IsOpaque Neighbour block is opaque flag
    */
-  VOID UpdateLeftSide( const glm::ivec3 &BlockPos );
+  VOID SetBorderCell( UINT32 Face, const glm::ivec3 &BlockPos, BOOL IsOpaque );
 
-  /**
-   * \brief Update down block border
-   * \param[in] BlockPos Block position
-   */
-  VOID UpdateDownSide( const glm::ivec3 &BlockPos );
+  /** Chunk position */
+  CHUNK_POS Position;
 
-  /**
-   * \brief Update right block border
-   * \param[in] BlockPos Block position
-   */
-  VOID UpdateRightSide( const glm::ivec3 &BlockPos );
+  /** Borders of meshed neighbours geometry is culled with (changed under active chunks mutex) */
+  CHUNK_BORDERS Borders;
 
-  /**
-   * \brief Update front block border
-   * \param[in] BlockPos Block position
-   */
-  VOID UpdateFrontSide( const glm::ivec3 &BlockPos );
+  /** Sections which geometry is outdated (bit i - section i, changed under active chunks mutex) */
+  UINT32 DirtySections = 0;
 
-  /**
-   * \brief Update back block border
-   * \param[in] BlockPos Block position
-   */
-  VOID UpdateBackSide( const glm::ivec3 &BlockPos );
+  /** Level of detail of geometry (changed under active chunks mutex) */
+  UINT32 Lod = 0;
 
-  /**
-   * \brief Update command buffer function
-   */
-  VOID UpdateCommandBuffer( VOID ) const;
+  /** Skirt faces of geometry (changed under active chunks mutex) */
+  UINT32 SkirtFaces = 0;
+
+  /** Hash of borders geometry was culled with (changed under active chunks mutex) */
+  UINT64 BordersHash = 0;
 
-  /** Chunk blocks */
-  std::array<BLOCK, ChunkSizeZ * ChunkSizeY * ChunkSizeX> Blocks;
+  /** Mesh saved with chunk blocks (nullptr after blocks edit or reuse, changed under active chunks mutex) */
+  std::shared_ptr<const CHUNK_MESH_CACHE> MeshCache;
+
+  /** Chunk re-mesh is in flight flag (changed under active chunks mutex) */
+  BOOL IsRemeshing = FALSE;
+
+  /** Quads of every section in geometry (changed by upload thread while chunk isn't re-meshing) */
+  std::array<std::vector<chunk_mesher::QUAD>, chunk_blocks::NumberOfSections> SectionQuads;
 
 private:
+  /** Chunk blocks (copied on edit, so lock-free readers never see partial changes) */
+  std::atomic<chunk_blocks *> Blocks;
+
   /** Object for drawing */
   std::unique_ptr<chunk_geometry> Geometry;
 
@@ -0,0 +1,197 @@
+#include <cfloat>
+#include <algorithm>
+
+#include "chunk_blocks.h"
+#include "block_type.h"
+
+/**
+ * \brief Set block function
+ * \param[in] Index Block index in chunk
+ * \param[in] Block New block state
+ */
+VOID chunk_blocks::Set( UINT32 Index, const BLOCK &Block )
+{
+  UINT32 x = Index % ChunkSizeX;
+  UINT32 y = Index / ChunkSizeX % ChunkSizeY;
+  UINT32 z = Index / (ChunkSizeX * ChunkSizeY);
+
+  BOOL WasAir = IsAir(Index);
+
+  Sections[y / SectionSize].Set((z * SectionSize + y % SectionSize) * SectionSize + x, Block);
+  UpdateBits(Index, Block);
+
+  if (WasAir != IsAir(Index))
+    UpdateHeights(x, y, z, !WasAir);
+}
+
+/**
+ * \brief Update heightmap and occupied Y bounds after block air state changed function
+ * \param[in] x Block X-coordinate
+ * \param[in] y Block Y-coordinate
+ * \param[in] z Block Z-coordinate
+ * \param[in] IsBlockAir New block air state
+ */
+VOID chunk_blocks::UpdateHeights( UINT32 x, UINT32 y, UINT32 z, BOOL IsBlockAir )
+{
+  INT16 &Height = Heights[z * ChunkSizeX + x];
+
+  if (!IsBlockAir)
+  {
+    LayerCounts[y]++;
+    Height = std::max(Height, (INT16)y);
+    MinY = std::min(MinY, (INT32)y);
+    MaxY = std::max(MaxY, (INT32)y);
+    return;
+  }
+
+  LayerCounts[y]--;
+
+  /* Only removing of top block needs column scan */
+  if (Height == (INT32)y)
+  {
+    Height--;
+
+    while (Height >= 0 && IsAir((z * ChunkSizeY + Height) * ChunkSizeX + x))
+      Height--;
+  }
+
+  if (LayerCounts[y] != 0)
+    return;
+
+  while (MinY <= MaxY && LayerCounts[MinY] == 0)
+    MinY++;
+
+  while (MaxY >= MinY && LayerCounts[MaxY] == 0)
+    MaxY--;
+
+  if (MinY > MaxY)
+  {
+    MinY = ChunkSizeY;
+    MaxY = -1;
+  }
+}
+
+/**
+ * \brief Build heightmap for empty chunk function
+ * \return Heightmap with all columns empty
+ */
+std::array<INT16, chunk_blocks::ChunkSizeX * chunk_blocks::ChunkSizeZ> chunk_blocks::BuildEmptyHeights( VOID )
+{
+  std::array<INT16, ChunkSizeX * ChunkSizeZ> Result;
+
+  Result.fill(-1);
+
+  return Result;
+}
+
+/**
+ * \brief Update bitsets for block function
+ * \param[in] Index Block index in chunk
+ * \param[in] Block Block state
+ */
+VOID chunk_blocks::UpdateBits( UINT32 Index, const BLOCK &Block )
+{
+  UINT64 Mask = 1ull << (Index & 63);
+
+  if (BLOCK_TYPE::Table[Block.BlockTypeId].Alpha >= 1 - FLT_EPSILON)
+    OpaqueBits[Index >> 6] |= Mask;
+  else
+    OpaqueBits[Index >> 6] &= ~Mask;
+
+  if (Block.BlockTypeId != BLOCK_TYPE::AirId)
+    NotAirBits[Index >> 6] |= Mask;
+  else
+    NotAirBits[Index >> 6] &= ~Mask;
+}
+
+/**
+ * \brief Get opaque blocks bitset function
+ * \return Bitset words (bit i is set if block i is opaque)
+ */
+const std::array<UINT64, chunk_blocks::NumberOfBitsetWords> & chunk_blocks::GetOpaqueBits( VOID ) const
+{
+  return OpaqueBits;
+}
+
+/**
+ * \brief Get not air blocks bitset function
+ * \return Bitset words (bit i is set if block i is not air)
+ */
+const std::array<UINT64, chunk_blocks::NumberOfBitsetWords> & chunk_blocks::GetNotAirBits( VOID ) const
+{
+  return NotAirBits;
+}
+
+/**
+ * \brief Convert sections to empty or uniform form if it is possible function
+ */
+VOID chunk_blocks::Compact( VOID )
+{
+  for (chunk_section &Section : Sections)
+    Section.Compact();
+}
+
+/**
+ * \brief Get section function
+ * \param[in] SectionId Section index (from bottom)
+ * \return Reference to section
+ */
+const chunk_section & chunk_blocks::GetSection( UINT32 SectionId ) const
+{
+  return Sections[SectionId];
+}
+
+/**
+ * \brief Get used memory function
+ * \return Size of used memory in bytes
+ */
+UINT64 chunk_blocks::GetMemoryUsage( VOID ) const
+{
+  UINT64 Size = sizeof(chunk_blocks) - sizeof(Sections);
+
+  for (const chunk_section &Section : Sections)
+    Size += Section.GetMemoryUsage();
+
+  return Size;
+}
+
+/**
+ * \brief Save blocks to bytes array function
+ * \param[in, out] Bytes Array for appending serialized data
+ */
+VOID chunk_blocks::Save( std::vector<BYTE> &Bytes ) const
+{
+  for (const chunk_section &Section : Sections)
+    Section.Save(Bytes);
+}
+
+/**
+ * \brief Load blocks from bytes array function
+ * \param[in] Bytes Serialized data
+ * \param[in] Size Serialized data size
+ * \return Number of read bytes
+ */
+UINT64 chunk_blocks::Load( const BYTE *Bytes, UINT64 Size )
+{
+  UINT64 Offset = 0;
+
+  for (chunk_section &Section : Sections)
+    Offset += Section.Load(Bytes + Offset, Size - Offset);
+
+  OpaqueBits.fill(0);
+  NotAirBits.fill(0);
+  Heights.fill(-1);
+  LayerCounts.fill(0);
+  MinY = ChunkSizeY;
+  MaxY = -1;
+
+  for (UINT32 i = 0; i < NumberOfBlocks; i++)
+  {
+    UpdateBits(i, Get(i));
+
+    if (!IsAir(i))
+      UpdateHeights(i % ChunkSizeX, i / ChunkSizeX % ChunkSizeY, i / (ChunkSizeX * ChunkSizeY), FALSE);
+  }
+
+  return Offset;
+}
@@ -0,0 +1,220 @@
+#ifndef __chunk_blocks_h_
+#define __chunk_blocks_h_
+
+#include <array>
+#include <vector>
+
+#include "def.h"
+#include "block.h"
+#include "chunk_section.h"
+
+/**
+ * \brief Chunk blocks class (chunk is split into vertical sections)
+ */
+class chunk_blocks
+{
+public:
+  /** Chunk size for X-coordinate */
+  static constexpr INT ChunkSizeX = 16;
+
+  /** Chunk size for Y-coordinate */
+  static constexpr INT ChunkSizeY = ENABLE_CUBIC_CHUNKS ? 16 : 256;
+
+  /** Chunk size for Z-coordinate */
+  static constexpr INT ChunkSizeZ = 16;
+
+  /** Section size for every coordinate */
+  static constexpr INT SectionSize = chunk_section::SectionSize;
+
+  /** Number of sections in chunk */
+  static constexpr UINT32 NumberOfSections = ChunkSizeY / SectionSize;
+
+  /** Number of blocks in chunk */
+  static constexpr UINT32 NumberOfBlocks = ChunkSizeX * ChunkSizeY * ChunkSizeZ;
+
+  /** Number of 64-bit words in blocks bitset */
+  static constexpr UINT32 NumberOfBitsetWords = NumberOfBlocks / 64;
+
+  /**
+   * \brief Get block function
+   * \param[in] Index Block index in chunk
+   * \return Reference to block state (valid until next Set call)
+   */
+  const BLOCK & Get( UINT32 Index ) const
+  {
+    UINT32 x = Index % ChunkSizeX;
+    UINT32 y = Index / ChunkSizeX % ChunkSizeY;
+    UINT32 z = Index / (ChunkSizeX * ChunkSizeY);
+
+    return Sections[y / SectionSize].Get((z * SectionSize + y % SectionSize) * SectionSize + x);
+  }
+
+  /**
+   * \brief Check if block is opaque function
+   * \param[in] Index Block index in chunk
+   * \return TRUE-if block is opaque, FALSE-if otherwise
+   */
+  BOOL IsOpaque( UINT32 Index ) const
+  {
+    return (OpaqueBits[Index >> 6] >> (Index & 63)) & 1;
+  }
+
+  /**
+   * \brief Check if block is air function
+   * \param[in] Index Block index in chunk
+   * \return TRUE-if block is air, FALSE-if otherwise
+   */
+  BOOL IsAir( UINT32 Index ) const
+  {
+    return ((NotAirBits[Index >> 6] >> (Index & 63)) & 1) == 0;
+  }
+
+  /**
+   * \brief Get not air blocks mask for blocks row along X-coordinate function
+   * \param[in] y Row Y-coordinate
+   * \param[in] z Row Z-coordinate
+   * \return Row mask (bit x is set if block x is not air)
+   */
+  UINT32 GetNotAirRow( UINT32 y, UINT32 z ) const
+  {
+    UINT32 Index = (z * ChunkSizeY + y) * ChunkSizeX;
+
+    return (NotAirBits[Index >> 6] >> (Index & 63)) & ((1u << ChunkSizeX) - 1);
+  }
+
+  /**
+   * \brief Get opaque blocks bitset function
+   * \return Bitset words (bit i is set if block i is opaque)
+   */
+  const std::array<UINT64, NumberOfBitsetWords> & GetOpaqueBits( VOID ) const;
+
+  /**
+   * \brief Get not air blocks bitset function
+   * \return Bitset words (bit i is set if block i is not air)
+   */
+  const std::array<UINT64, NumberOfBitsetWords> & GetNotAirBits( VOID ) const;
+
+  /**
+   * \brief Get column height function
+   * \param[in] x Column X-coordinate
+   * \param[in] z Column Z-coordinate
+   * \return Y-coordinate of highest not air block in column (-1 if column is empty)
+   */
+  INT32 GetHeight( UINT32 x, UINT32 z ) const
+  {
+    return Heights[z * ChunkSizeX + x];
+  }
+
+  /**
+   * \brief Get minimal occupied Y-coordinate function
+   * \return Y-coordinate of lowest not air block (ChunkSizeY if chunk is empty)
+   */
+  INT32 GetMinY( VOID ) const
+  {
+    return MinY;
+  }
+
+  /**
+   * \brief Get maximal occupied Y-coordinate function
+   * \return Y-coordinate of highest not air block (-1 if chunk is empty)
+   */
+  INT32 GetMaxY( VOID ) const
+  {
+    return MaxY;
+  }
+
+  /**
+   * \brief Set block function
+   * \param[in] Index Block index in chunk
+   * \param[in] Block New block state
+   */
+  VOID Set( UINT32 Index, const BLOCK &Block );
+
+  /**
+   * \brief Convert sections to empty or uniform form if it is possible function
+   */
+  VOID Compact( VOID );
+
+  /**
+   * \brief Get section function
+   * \param[in] SectionId Section index (from bottom)
+   * \return Reference to section
+   */
+  const chunk_section & GetSection( UINT32 SectionId ) const;
+
+  /**
+   * \brief Check if section contains only air function
+   * \param[in] SectionId Section index (from bottom)
+   * \return TRUE-if section is empty, FALSE-if otherwise
+   */
+  BOOL IsSectionEmpty( UINT32 SectionId ) const
+  {
+    return Sections[SectionId].IsEmpty();
+  }
+
+  /**
+   * \brief Get used memory function
+   * \return Size of used memory in bytes
+   */
+  UINT64 GetMemoryUsage( VOID ) const;
+
+  /**
+   * \brief Save blocks to bytes array function
+   * \param[in, out] Bytes Array for appending serialized data
+   */
+  VOID Save( std::vector<BYTE> &Bytes ) const;
+
+  /**
+   * \brief Load blocks from bytes array function
+   * \param[in] Bytes Serialized data
+   * \param[in] Size Serialized data size
+   * \return Number of read bytes
+   */
+  UINT64 Load( const BYTE *Bytes, UINT64 Size );
+
+private:
+  /**
+   * \brief Update bitsets for block function
+   * \param[in] Index Block index in chunk
+   * \param[in] Block Block state
+   */
+  VOID UpdateBits( UINT32 Index, const BLOCK &Block );
+
+  /**
+   * \brief Update heightmap and occupied Y bounds after block air state changed function
+   * \param[in] x Block X-coordinate
+   * \param[in] y Block Y-coordinate
+   * \param[in] z Block Z-coordinate
+   * \param[in] IsBlockAir New block air state
+   */
+  VOID UpdateHeights( UINT32 x, UINT32 y, UINT32 z, BOOL IsBlockAir );
+
+  /** Chunk sections (from bottom to top) */
+  std::array<chunk_section, NumberOfSections> Sections;
+
+  /** Opaque blocks bitset */
+  std::array<UINT64, NumberOfBitsetWords> OpaqueBits = {};
+
+  /** Not air blocks bitset */
+  std::array<UINT64, NumberOfBitsetWords> NotAirBits = {};
+
+  /** Highest not air block Y-coordinate for every column (-1 for empty column) */
+  std::array<INT16, ChunkSizeX * ChunkSizeZ> Heights = BuildEmptyHeights();
+
+  /** Number of not air blocks in every horizontal layer */
+  std::array<UINT16, ChunkSizeY> LayerCounts = {};
+
+  /** Lowest occupied Y-coordinate */
+  INT32 MinY = ChunkSizeY;
+
+  /** Highest occupied Y-coordinate */
+  INT32 MaxY = -1;
+
+  /**
+   * \brief Build heightmap for empty chunk function
+   * \return Heightmap with all columns empty
+   */
+  static std::array<INT16, ChunkSizeX * ChunkSizeZ> BuildEmptyHeights( VOID );
+};
+
+#endif /* __chunk_blocks_h_ */
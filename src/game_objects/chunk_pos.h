@@ -0,0 +1,68 @@
+#ifndef __chunk_pos_h_
+#define __chunk_pos_h_
+
+#include <tuple>
+
+#include "def.h"
+
+/**
+ * \brief Chunk position (in chunks, Y-coordinate is always 0 without cubic chunks)
+ */
+struct CHUNK_POS
+{
+  /** X-coordinate */
+  INT32 X = 0;
+
+  /** Y-coordinate */
+  INT32 Y = 0;
+
+  /** Z-coordinate */
+  INT32 Z = 0;
+
+  /**
+   * \brief Chunk position default constructor
+   */
+  CHUNK_POS( VOID ) = default;
+
+  /**
+   * \brief Chunk position constructor
+   * \param[in] X X-coordinate
+   * \param[in] Y Y-coordinate
+   * \param[in] Z Z-coordinate
+   */
+  CHUNK_POS( INT32 X, INT32 Y, INT32 Z ) : X(X), Y(Y), Z(Z)
+  {
+  }
+
+  /**
+   * \brief Compare positions function
+   * \param[in] Other Other position
+   * \return TRUE-if positions are equal, FALSE-if otherwise
+   */
+  BOOL operator==( const CHUNK_POS &Other ) const
+  {
+    return X == Other.X && Y == Other.Y && Z == Other.Z;
+  }
+
+  /**
+   * \brief Compare positions function
+   * \param[in] Other Other position
+   * \return TRUE-if positions aren't equal, FALSE-if otherwise
+   */
+  BOOL operator!=( const CHUNK_POS &Other ) const
+  {
+    return !(*this == Other);
+  }
+
+  /**
+   * \brief Compare positions function (for ordered containers)
+   * \param[in] Other Other position
+   * \return TRUE-if position is less, FALSE-if otherwise
+   */
+  BOOL operator<( const CHUNK_POS &Other ) const
+  {
+    return std::tie(X, Y, Z) < std::tie(Other.X, Other.Y, Other.Z);
+  }
+};
+
+#endif /* __chunk_pos_h_ */
@@ -0,0 +1,193 @@
+#include <stdexcept>
+
+#include "chunk_section.h"
+#include "block_type.h"
+
+/**
+ * \brief Copy constructor (palette storage is copied)
+ * \param[in] Section Chunk section
+ */
+chunk_section::chunk_section( const chunk_section &Section )
+{
+  *this = Section;
+}
+
+/**
+ * \brief Copy function (palette storage is copied)
+ * \param[in] Section Chunk section
+ * \return Reference to this
+ */
+chunk_section & chunk_section::operator=( const chunk_section &Section )
+{
+  if (this == &Section)
+    return *this;
+
+  Kind = Section.Kind;
+  UniformBlock = Section.UniformBlock;
+  NumberOfNotAirBlocks = Section.NumberOfNotAirBlocks;
+  Storage = Section.Storage != nullptr ? std::make_unique<block_storage>(*Section.Storage) : nullptr;
+
+  return *this;
+}
+
+/**
+ * \brief Set block function
+ * \param[in] Index Block index in section
+ * \param[in] Block New block state
+ */
+VOID chunk_section::Set( UINT32 Index, const BLOCK &Block )
+{
+  if (Kind == SECTION_KIND::EMPTY)
+  {
+    if (IsAir(Block))
+      return;
+
+    Storage = std::make_unique<block_storage>(NumberOfBlocks);
+    NumberOfNotAirBlocks = 0;
+    Kind = SECTION_KIND::PALETTE;
+  }
+  else if (Kind == SECTION_KIND::UNIFORM)
+  {
+    if (Block == UniformBlock)
+      return;
+
+    Storage = std::make_unique<block_storage>(NumberOfBlocks, UniformBlock);
+    NumberOfNotAirBlocks = NumberOfBlocks;
+    Kind = SECTION_KIND::PALETTE;
+  }
+
+  BOOL WasAir = IsAir(Storage->Get(Index));
+
+  Storage->Set(Index, Block);
+
+  if (WasAir && !IsAir(Block))
+    NumberOfNotAirBlocks++;
+  else if (!WasAir && IsAir(Block))
+    NumberOfNotAirBlocks--;
+
+  if (NumberOfNotAirBlocks == 0)
+  {
+    Storage = nullptr;
+    UniformBlock = BLOCK();
+    Kind = SECTION_KIND::EMPTY;
+  }
+}
+
+/**
+ * \brief Convert section to empty or uniform form if it is possible function
+ */
+VOID chunk_section::Compact( VOID )
+{
+  if (Kind != SECTION_KIND::PALETTE || NumberOfNotAirBlocks != NumberOfBlocks)
+    return;
+
+  const BLOCK &First = Storage->Get(0);
+
+  for (UINT32 i = 1; i < NumberOfBlocks; i++)
+    if (!(Storage->Get(i) == First))
+      return;
+
+  UniformBlock = First;
+  Storage = nullptr;
+  Kind = SECTION_KIND::UNIFORM;
+}
+
+/**
+ * \brief Get section kind function
+ * \return Section kind
+ */
+chunk_section::SECTION_KIND chunk_section::GetKind( VOID ) const
+{
+  return Kind;
+}
+
+/**
+ * \brief Get used memory function
+ * \return Size of used memory in bytes
+ */
+UINT64 chunk_section::GetMemoryUsage( VOID ) const
+{
+  return sizeof(chunk_section) + (Storage != nullptr ? Storage->GetMemoryUsage() : 0);
+}
+
+/**
+ * \brief Save section to bytes array function
+ * \param[in, out] Bytes Array for appending serialized data
+ */
+VOID chunk_section::Save( std::vector<BYTE> &Bytes ) const
+{
+  Bytes.push_back((BYTE)Kind);
+
+  if (Kind == SECTION_KIND::UNIFORM)
+  {
+    UINT64 Offset = Bytes.size();
+
+    Bytes.resize(Offset + block_storage::SavedBlockSize);
+    block_storage::SaveBlock(UniformBlock, Bytes.data() + Offset);
+  }
+  else if (Kind == SECTION_KIND::PALETTE)
+    Storage->Save(Bytes);
+}
+
+/**
+ * \brief Load section from bytes array function
+ * \param[in] Bytes Serialized data
+ * \param[in] Size Serialized data size
+ * \return Number of read bytes
+ */
+UINT64 chunk_section::Load( const BYTE *Bytes, UINT64 Size )
+{
+  if (Size < 1)
+    throw std::runtime_error("chunk section data corrupted");
+
+  Storage = nullptr;
+  UniformBlock = BLOCK();
+  NumberOfNotAirBlocks = 0;
+
+  switch ((SECTION_KIND)Bytes[0])
+  {
+  case SECTION_KIND::EMPTY:
+    Kind = SECTION_KIND::EMPTY;
+    return 1;
+
+  case SECTION_KIND::UNIFORM:
+    if (Size < 1 + block_storage::SavedBlockSize)
+      throw std::runtime_error("chunk section data corrupted");
+
+    UniformBlock = block_storage::LoadBlock(Bytes + 1);
+    Kind = IsAir(UniformBlock) ? SECTION_KIND::EMPTY : SECTION_KIND::UNIFORM;
+    return 1 + block_storage::SavedBlockSize;
+
+  case SECTION_KIND::PALETTE:
+    {
+      Storage = std::make_unique<block_storage>(NumberOfBlocks);
+      Kind = SECTION_KIND::PALETTE;
+
+      UINT64 ReadSize = 1 + Storage->Load(Bytes + 1, Size - 1);
+
+      for (UINT32 i = 0; i < NumberOfBlocks; i++)
+        if (!IsAir(Storage->Get(i)))
+          NumberOfNotAirBlocks++;
+
+      if (NumberOfNotAirBlocks == 0)
+      {
+        Storage = nullptr;
+        Kind = SECTION_KIND::EMPTY;
+      }
+
+      return ReadSize;
+    }
+  }
+
+  throw std::runtime_error("chunk section data corrupted");
+}
+
+/**
+ * \brief Check if block is air function
+ * \param[in] Block Block state
+ * \return TRUE-if block is air, FALSE-if otherwise
+ */
+BOOL chunk_section::IsAir( const BLOCK &Block )
+{
+  return Block.BlockTypeId == BLOCK_TYPE::AirId;
+}
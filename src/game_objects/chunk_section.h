@@ -0,0 +1,146 @@
+#ifndef __chunk_section_h_
+#define __chunk_section_h_
+
+#include <memory>
+#include <vector>
+
+#include "def.h"
+#include "block.h"
+#include "block_storage.h"
+
+/**
+ * \brief Chunk section (16x16x16 blocks) class
+ *
+ * Section is stored in one of three forms: empty (only air, no storage),
+ * uniform (one block state for all blocks) or palette (block_storage).
+ */
+class chunk_section
+{
+public:
+  /** Section kind enumeration */
+  enum class SECTION_KIND
+  {
+    EMPTY = 0,   // All blocks are air
+    UNIFORM = 1, // All blocks have same state
+    PALETTE = 2  // Blocks are stored in palette storage
+  };
+
+  /** Section size for every coordinate */
+  static constexpr INT SectionSize = 16;
+
+  /** Number of blocks in section */
+  static constexpr UINT32 NumberOfBlocks = SectionSize * SectionSize * SectionSize;
+
+  /**
+   * \brief Chunk section default constructor (all blocks are air)
+   */
+  chunk_section( VOID ) = default;
+
+  /**
+   * \brief Copy constructor (palette storage is copied)
+   * \param[in] Section Chunk section
+   */
+  chunk_section( const chunk_section &Section );
+
+  /**
+   * \brief Copy function (palette storage is copied)
+   * \param[in] Section Chunk section
+   * \return Reference to this
+   */
+  chunk_section & operator=( const chunk_section &Section );
+
+  /**
+   * \brief Move constructor
+   * \param[in] Section Chunk section
+   */
+  chunk_section( chunk_section &&Section ) noexcept = default;
+
+  /**
+   * \brief Move function
+   * \param[in] Section Chunk section
+   * \return Reference to this
+   */
+  chunk_section & operator=( chunk_section &&Section ) noexcept = default;
+
+  /**
+   * \brief Get block function
+   * \param[in] Index Block index in section
+   * \return Reference to block state (valid until next Set call)
+   */
+  const BLOCK & Get( UINT32 Index ) const
+  {
+    if (Kind == SECTION_KIND::PALETTE)
+      return Storage->Get(Index);
+
+    return UniformBlock;
+  }
+
+  /**
+   * \brief Set block function
+   * \param[in] Index Block index in section
+   * \param[in] Block New block state
+   */
+  VOID Set( UINT32 Index, const BLOCK &Block );
+
+  /**
+   * \brief Convert section to empty or uniform form if it is possible function
+   */
+  VOID Compact( VOID );
+
+  /**
+   * \brief Get section kind function
+   * \return Section kind
+   */
+  SECTION_KIND GetKind( VOID ) const;
+
+  /**
+   * \brief Check if section contains only air function
+   * \return TRUE-if section is empty, FALSE-if otherwise
+   */
+  BOOL IsEmpty( VOID ) const
+  {
+    return Kind == SECTION_KIND::EMPTY;
+  }
+
+  /**
+   * \brief Get used memory function
+   * \return Size of used memory in bytes
+   */
+  UINT64 GetMemoryUsage( VOID ) const;
+
+  /**
+   * \brief Save section to bytes array function
+   * \param[in, out] Bytes Array for appending serialized data
+   */
+  VOID Save( std::vector<BYTE> &Bytes ) const;
+
+  /**
+   * \brief Load section from bytes array function
+   * \param[in] Bytes Serialized data
+   * \param[in] Size Serialized data size
+   * \return Number of read bytes
+   */
+  UINT64 Load( const BYTE *Bytes, UINT64 Size );
+
+private:
+  /**
+   * \brief Check if block is air function
+   * \param[in] Block Block state
+   * \return TRUE-if block is air, FALSE-if otherwise
+   */
+  static BOOL IsAir( const BLOCK &Block );
+
+  /** Section kind */
+  SECTION_KIND Kind = SECTION_KIND::EMPTY;
+
+  /** Block state for empty and uniform sections */
+  BLOCK UniformBlock;
+
+  /** Number of not air blocks in palette section */
+  UINT32 NumberOfNotAirBlocks = 0;
+
+  /** Palette storage (only for palette sections) */
+  std::unique_ptr<block_storage> Storage;
+};
+
+#endif /* __chunk_section_h_ */
@@ -1,6 +1,10 @@
 #include <iostream>
 #include <fstream>
 #include <filesystem>
+#include <cstring>
+#include <thread>
+#include <algorithm>
+#include <optional>
 #include "ext/zlib/zlib.h"
 
 #include "chunks_manager.h"
@@ -11,22 +15,33 @@
  * \brief Chunks manager constructor
  * \param Render Render object
  * \param RenderDistance Render distance in chunks
+ * \param VerticalRenderDistance Vertical render distance in chunks (ignored without cubic chunks)
+ * \param[in] LodDistances Distances in chunks beyond which chunks are meshed with next level of detail
  * \param[in] Player Reference to player
+ * \param[in] NumberOfMeshingThreads Number of chunk meshing threads (0 - number of hardware threads without one)
  */
-chunks_manager::chunks_manager( render &Render, INT RenderDistance, player &Player ) :
-  Render(Render), RenderDistance(RenderDistance), Player(Player)
+chunks_manager::chunks_manager( render &Render, INT RenderDistance, INT VerticalRenderDistance,
+                                const std::array<INT, chunk_mesher::NumberOfLods - 1> &LodDistances, player &Player,
+                                UINT32 NumberOfMeshingThreads ) :
+  Render(Render), RenderDistance(RenderDistance),
+  VerticalRenderDistance(ENABLE_CUBIC_CHUNKS ? VerticalRenderDistance : 0), LodDistances(LodDistances),
+  GridSize(2 * RenderDistance + 1),
+  GridSizeY(ENABLE_CUBIC_CHUNKS ? 2 * VerticalRenderDistance + 1 : 1),
+  ActiveChunks((2 * RenderDistance + 1) * (2 * RenderDistance + 1) *
+               (ENABLE_CUBIC_CHUNKS ? 2 * VerticalRenderDistance + 1 : 1)),
+  Player(Player)
 {
   ExitFlag.store(FALSE, std::memory_order_seq_cst);
 
   {
-    std::string FileName = "world/saved.txt";
+    std::string FileName = std::string(WorldDirectory) + "/saved.txt";
     std::ifstream File(FileName);
 
     if (File)
     {
-      std::pair<INT32, INT32> Pos;
+      CHUNK_POS Pos;
 
-      while ((File >> Pos.first) && (File >> Pos.second))
+      while ((File >> Pos.X) && (!ENABLE_CUBIC_CHUNKS || (File >> Pos.Y)) && (File >> Pos.Z))
         ChunksInDrive.insert(Pos);
     }
   }
@@ -59,6 +74,45 @@ chunks_manager::chunks_manager( render &Render, INT RenderDistance, player &Play
     }
   });
 
+  if (NumberOfMeshingThreads == 0)
+    NumberOfMeshingThreads = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+
+  /* Every meshing thread is epoch reader, leave slots for other readers */
+  NumberOfMeshingThreads = std::min(NumberOfMeshingThreads, epoch_manager::MaxReaders / 2);
+
+  for (UINT32 i = 0; i < NumberOfMeshingThreads; i++)
+    MeshingThreads.push_back(std::async(std::launch::async, [&]( VOID )
+    {
+      try
+      {
+        CHUNK_POS ChunkPos;
+
+        while (MeshRequests.wait_pull(ChunkPos) != boost::concurrent::queue_op_status::closed)
+          MeshChunk(ChunkPos);
+      }
+      catch ( const std::runtime_error &Err )
+      {
+        std::cout << "Error:\n  " << Err.what() << "\n";
+        exit(1);
+      }
+    }));
+
+  UploadThread = std::async(std::launch::async, [&]( VOID )
+  {
+    try
+    {
+      MESH_RESULT Result;
+
+      while (MeshResults.wait_pull(Result) != boost::concurrent::queue_op_status::closed)
+        UploadChunk(Result);
+    }
+    catch ( const std::runtime_error &Err )
+    {
+      std::cout << "Error:\n  " << Err.what() << "\n";
+      exit(1);
+    }
+  });
+
   ChunksControllerThread = std::async([&]( VOID )
   {
     try
@@ -76,7 +130,7 @@ chunks_manager::chunks_manager( render &Render, INT RenderDistance, player &Play
     }
   });
 
-  SetCurrentChunk(std::pair<INT32, INT32>(0, 0));
+  SetCurrentChunk(Player.GetCurrentChunk());
 }
 
 /**
@@ -94,90 +148,323 @@ std::mutex & chunks_manager::GetActiveChunksMutex( VOID )
  * \param[in, out] ChunkPtr Reference to pointer to chunk
  * \return Chunk exists flag
  */
-BOOL chunks_manager::GetChunk( const std::pair<INT32, INT32> &ChunkPos, chunk *&ChunkPtr )
+BOOL chunks_manager::GetChunk( const CHUNK_POS &ChunkPos, chunk *&ChunkPtr )
 {
-  std::map<std::pair<INT32, INT32>, chunk>::iterator It = ActiveChunks.find(ChunkPos);
+  CHUNK_SLOT &Slot = ActiveChunks[GetSlotIndex(ChunkPos)];
 
-  if (It == ActiveChunks.end())
+  if (Slot.State != CHUNK_STATE::MESHED || Slot.ChunkPos != ChunkPos)
     return FALSE;
 
-  ChunkPtr = &It->second;
+  ChunkPtr = Slot.Chunk.get();
 
   return TRUE;
 }
 
 /**
- * \brief Update block geometry
+ * \brief Get epoch manager for lock-free chunk readers function
+ * \return Reference to epoch manager
+ */
+epoch_manager & chunks_manager::GetEpochManager( VOID )
+{
+  return Epochs;
+}
+
+/**
+ * \brief Get published chunk without locking function (must be called inside epoch guard)
+ * \param[in] ChunkPos Chunk position
+ * \return Pointer to chunk (valid until guard leaves epoch) or nullptr if chunk isn't loaded
+ */
+const chunk * chunks_manager::GetPublishedChunk( const CHUNK_POS &ChunkPos ) const
+{
+  const chunk *ChunkPtr = ActiveChunks[GetSlotIndex(ChunkPos)].Published.load();
+
+  if (ChunkPtr == nullptr || ChunkPtr->Position != ChunkPos)
+    return nullptr;
+
+  return ChunkPtr;
+}
+
+/**
+ * \brief Get active chunks grid slot index function
+ * \param[in] ChunkPos Chunk position
+ * \return Slot index (chunk position modulo grid size)
+ */
+UINT32 chunks_manager::GetSlotIndex( const CHUNK_POS &ChunkPos ) const
+{
+  INT32 SlotX = (ChunkPos.X % GridSize + GridSize) % GridSize;
+  INT32 SlotY = (ChunkPos.Y % GridSizeY + GridSizeY) % GridSizeY;
+  INT32 SlotZ = (ChunkPos.Z % GridSize + GridSize) % GridSize;
+
+  return (SlotZ * GridSizeY + SlotY) * GridSize + SlotX;
+}
+
+/**
+ * \brief Get chunk save file name function
+ * \param[in] ChunkPos Chunk position
+ * \param[in] Extension File extension (".chunk" - blocks, ".mesh" - mesh cache)
+ * \return File name
+ */
+std::string chunks_manager::GetChunkFileName( const CHUNK_POS &ChunkPos, const CHAR *Extension )
+{
+  std::string FileName = std::string(WorldDirectory) + "/" + std::to_string(ChunkPos.X) + ",";
+
+  if (ENABLE_CUBIC_CHUNKS)
+    FileName += std::to_string(ChunkPos.Y) + ",";
+
+  return FileName + std::to_string(ChunkPos.Z) + Extension;
+}
+
+/**
+ * \brief Write compressed data to file function
+ * \param[in] FileName File name
+ * \param[in] Data Uncompressed data
+ */
+VOID chunks_manager::WriteCompressedFile( const std::string &FileName, const std::vector<BYTE> &Data )
+{
+  std::ofstream File(FileName, std::ios::binary);
+
+  if (!File)
+    throw std::runtime_error("file not opened for write");
+
+  UINT32 SrcDataSize = Data.size();
+
+  uLongf DstDataSize = compressBound(SrcDataSize);
+
+  std::vector<BYTE> CompressedData(DstDataSize);
+
+  INT CompressionRes = compress(reinterpret_cast<Bytef *>(CompressedData.data()),
+    &DstDataSize,
+    reinterpret_cast<const Bytef *>(Data.data()),
+    SrcDataSize);
+
+  if (CompressionRes != Z_OK)
+    throw std::runtime_error("compression error");
+
+  File.write(reinterpret_cast<const CHAR *>(&SrcDataSize), sizeof(UINT32));
+  File.write(reinterpret_cast<const CHAR *>(CompressedData.data()), DstDataSize);
+}
+
+/**
+ * \brief Read compressed data from file function
+ * \param[in] FileName File name
+ * \param[out] Data Uncompressed data
+ */
+VOID chunks_manager::ReadCompressedFile( const std::string &FileName, std::vector<BYTE> &Data )
+{
+  std::ifstream File(FileName, std::ios::binary | std::ios::ate);
+
+  if (!File)
+    throw std::runtime_error("file not opened for read");
+
+  INT64 Size = File.tellg();
+  std::vector<CHAR> Bytes(Size);
+
+  File.seekg(std::ios::beg);
+  File.read(Bytes.data(), Size);
+
+  UINT32 DstDataSize = 0;
+
+  if (Bytes.size() < sizeof(UINT32))
+    throw std::runtime_error("decompression error");
+
+  memcpy(&DstDataSize, Bytes.data(), sizeof(UINT32));
+
+  Data.resize(DstDataSize);
+  uLongf DecompressedSize = DstDataSize;
+
+  INT DecompressionRes = uncompress(
+    reinterpret_cast<Bytef *>(Data.data()),
+    &DecompressedSize,
+    reinterpret_cast<const Bytef *>(Bytes.data() + sizeof(UINT32)),
+    (Bytes.size() - sizeof(UINT32)) * sizeof(BYTE));
+
+  if (DecompressionRes != Z_OK || DecompressedSize != DstDataSize)
+    throw std::runtime_error("decompression error");
+}
+
+/**
+ * \brief Load mesh saved with chunk function
+ * \param[in] ChunkPos Chunk position
+ * \param[in] BlocksHash Hash of loaded blocks data
+ * \return Saved mesh or nullptr if it is missing, corrupted or was built from other blocks
+ */
+std::shared_ptr<const CHUNK_MESH_CACHE> chunks_manager::LoadMeshCache( const CHUNK_POS &ChunkPos, UINT64 BlocksHash )
+{
+  std::string FileName = GetChunkFileName(ChunkPos, ".mesh");
+
+  if (!std::filesystem::exists(FileName))
+    return nullptr;
+
+  std::vector<BYTE> Data;
+
+  /* Mesh is only cache - chunk is re-meshed if it can't be read */
+  try
+  {
+    ReadCompressedFile(FileName, Data);
+  }
+  catch ( const std::runtime_error & )
+  {
+    return nullptr;
+  }
+
+  std::shared_ptr<CHUNK_MESH_CACHE> Cache = std::make_shared<CHUNK_MESH_CACHE>();
+
+  if (!Cache->Load(Data.data(), Data.size()) || Cache->BlocksHash != BlocksHash)
+    return nullptr;
+
+  return Cache;
+}
+
+/**
+ * \brief Check if chunk position is in active window function
+ * \param[in] ChunkPos Chunk position
+ * \param[in] CentralChunk Window central chunk
+ * \return TRUE-if chunk is in window, FALSE-if otherwise
+ */
+BOOL chunks_manager::IsInWindow( const CHUNK_POS &ChunkPos,
+                                 const CHUNK_POS &CentralChunk ) const
+{
+  return std::abs(ChunkPos.X - CentralChunk.X) <= RenderDistance &&
+         std::abs(ChunkPos.Y - CentralChunk.Y) <= VerticalRenderDistance &&
+         std::abs(ChunkPos.Z - CentralChunk.Z) <= RenderDistance;
+}
+
+/**
+ * \brief Get level of detail of chunk function (active chunks mutex must be locked)
+ * \param[in] ChunkPos Chunk position
+ * \return Level of detail by distance to current central chunk
+ */
+UINT32 chunks_manager::GetLod( const CHUNK_POS &ChunkPos ) const
+{
+  INT Distance = std::max({std::abs(ChunkPos.X - CurrentCentralChunk.X), std::abs(ChunkPos.Z - CurrentCentralChunk.Z),
+                           ENABLE_CUBIC_CHUNKS ? std::abs(ChunkPos.Y - CurrentCentralChunk.Y) : 0});
+  UINT32 Lod = 0;
+
+  while (Lod < LodDistances.size() && Distance > LodDistances[Lod])
+    Lod++;
+
+  return Lod;
+}
+
+/**
+ * \brief Get skirt faces of chunk function (active chunks mutex must be locked)
+ *
+ * Border faces of skirt directions aren't culled by neighbour, they hide cracks between levels of detail.
+ * \param[in] ChunkPos Chunk position
+ * \return Faces mask (bit i is set for face direction i)
+ */
+UINT32 chunks_manager::GetSkirtFaces( const CHUNK_POS &ChunkPos ) const
+{
+  UINT32 Lod = GetLod(ChunkPos);
+
+  /* Downsampled blocks don't match neighbour borders, so all border faces of far chunk are skirts */
+  if (Lod > 0)
+    return (1 << BLOCK::NumberOfFaces) - 1;
+
+  UINT32 Faces = 0;
+
+  for (UINT32 Face = 0; Face < BLOCK::NumberOfFaces; Face++)
+    if (GetLod(GetNeighbourPos(ChunkPos, Face)) != Lod)
+      Faces |= 1 << Face;
+
+  return Faces;
+}
+
+/**
+ * \brief Set block of meshed chunk and request re-mesh function (active chunks mutex must be locked)
+ * \param[in] ChunkPos Chunk position
+ * \param[in] BlockPos Block position
+ * \param[in] Block New block
+ */
+VOID chunks_manager::SetBlock( const CHUNK_POS &ChunkPos, const glm::ivec3 &BlockPos, const BLOCK &Block )
+{
+  chunk *ChunkPtr = nullptr;
+
+  if (!GetChunk(ChunkPos, ChunkPtr))
+    return;
+
+  /* Lock-free readers and meshing threads keep using old blocks, they are deleted after readers leave epoch */
+  std::unique_ptr<chunk_blocks> NewBlocks = std::make_unique<chunk_blocks>(ChunkPtr->GetBlocks());
+
+  NewBlocks->Set(chunk_mesher::GetIndex(BlockPos), Block);
+  Epochs.Retire([Blocks = ChunkPtr->SetBlocks(std::move(NewBlocks)).release()]( VOID )
+  {
+    delete Blocks;
+  });
+
+  UpdateBlock(ChunkPos, BlockPos);
+}
+
+/**
+ * \brief Mark block sections as dirty and request re-mesh function (active chunks mutex must be locked)
  * \param ChunkPos Chunk position
  * \param BlockPos Block position
  */
-VOID chunks_manager::UpdateBlock( const std::pair<INT32, INT32> &ChunkPos, const glm::ivec3 &BlockPos )
+VOID chunks_manager::UpdateBlock( const CHUNK_POS &ChunkPos, const glm::ivec3 &BlockPos )
 {
   chunk *ChunkPtr = nullptr;
-  BOOL GetChunkResult = GetChunk(ChunkPos, ChunkPtr);
 
-  if (GetChunkResult)
-    ChunkPtr->UpdateBlock(BlockPos);
-
-  INT64 GlobalX = chunk::ChunkSizeX * (INT64)ChunkPos.first + BlockPos.x;
-  INT64 GlobalZ = chunk::ChunkSizeZ * (INT64)ChunkPos.second + BlockPos.z;
+  if (!GetChunk(ChunkPos, ChunkPtr))
+    return;
 
-  UpdateBlockSide(GlobalX - 1, BlockPos.y, GlobalZ, ChunkPos, ChunkPtr, &chunk::UpdateRightSide);
-  UpdateBlockSide(GlobalX + 1, BlockPos.y, GlobalZ, ChunkPos, ChunkPtr, &chunk::UpdateLeftSide);
-  UpdateBlockSide(GlobalX, BlockPos.y, GlobalZ - 1, ChunkPos, ChunkPtr, &chunk::UpdateFrontSide);
-  UpdateBlockSide(GlobalX, BlockPos.y, GlobalZ + 1, ChunkPos, ChunkPtr, &chunk::UpdateBackSide);
+  /* Faces of blocks above and below can be in adjacent sections */
+  ChunkPtr->MarkRowsDirty(BlockPos.y - 1, BlockPos.y + 1);
+  ChunkPtr->MeshCache = nullptr;
+  MeshRequests.wait_push(ChunkPos);
 
-  if (BlockPos.y > 0)
-    UpdateBlockSide(GlobalX, BlockPos.y - 1, GlobalZ, ChunkPos, ChunkPtr, &chunk::UpdateUpSide);
+  BOOL IsBlockOpaque = ChunkPtr->GetBlocks().IsOpaque(chunk_mesher::GetIndex(BlockPos));
 
-  if (BlockPos.y < chunk::ChunkSizeY - 1)
-    UpdateBlockSide(GlobalX, BlockPos.y + 1, GlobalZ, ChunkPos, ChunkPtr, &chunk::UpdateDownSide);
+  INT64 GlobalX = chunk::ChunkSizeX * (INT64)ChunkPos.X + BlockPos.x;
+  INT64 GlobalY = chunk::ChunkSizeY * (INT64)ChunkPos.Y + BlockPos.y;
+  INT64 GlobalZ = chunk::ChunkSizeZ * (INT64)ChunkPos.Z + BlockPos.z;
 
-  if (GetChunkResult)
-    ChunkPtr->UpdateCommandBuffer();
+  UpdateBlockSide(GlobalX - 1, GlobalY, GlobalZ, ChunkPos, BLOCK::FaceRight, IsBlockOpaque);
+  UpdateBlockSide(GlobalX + 1, GlobalY, GlobalZ, ChunkPos, BLOCK::FaceLeft, IsBlockOpaque);
+  UpdateBlockSide(GlobalX, GlobalY, GlobalZ - 1, ChunkPos, BLOCK::FaceFront, IsBlockOpaque);
+  UpdateBlockSide(GlobalX, GlobalY, GlobalZ + 1, ChunkPos, BLOCK::FaceBack, IsBlockOpaque);
 
+  /* Column chunks have no neighbours above and below */
+  if (ENABLE_CUBIC_CHUNKS)
   {
-    std::lock_guard<std::mutex> Lock(Render.Synchronization.RenderMutex);
-
-    Render.UpdateCommandBuffers();
+    UpdateBlockSide(GlobalX, GlobalY - 1, GlobalZ, ChunkPos, BLOCK::FaceUp, IsBlockOpaque);
+    UpdateBlockSide(GlobalX, GlobalY + 1, GlobalZ, ChunkPos, BLOCK::FaceDown, IsBlockOpaque);
   }
 }
 
 /**
- * \brief Update block side
+ * \brief Update block side in neighbour chunk (sides in same chunk are re-meshed with block section)
  * \param[in] x Block x-coordinate
  * \param[in] y Block y-coordinate
  * \param[in] z Block z-coordinate
- * \param[in] ChunkPos Loaded chunk position
- * \param[in, out] ChunkPtr Pointer to chunk
- * \param[in] UpdateFunction Update block side function
+ * \param[in] ChunkPos Updated block chunk position
+ * \param[in] Face Updated side (BLOCK::Face* constant)
+ * \param[in] IsUpdatedBlockOpaque Updated block is opaque flag (for neighbour chunk border)
  */
-VOID chunks_manager::UpdateBlockSide( INT64 x, INT64 y, INT64 z,
-                                      const std::pair<INT32, INT32> &ChunkPos,
-                                      chunk *ChunkPtr,
-                                      VOID (chunk::*UpdateFunction)( const glm::ivec3 &BlockPos ) )
+VOID chunks_manager::UpdateBlockSide( INT64 x, INT64 y, INT64 z, const CHUNK_POS &ChunkPos, UINT32 Face,
+                                      BOOL IsUpdatedBlockOpaque )
 {
-  std::pair<INT32, INT32> NewChunkPos(
+  CHUNK_POS NewChunkPos(
     static_cast<INT32>(std::floor(static_cast<DBL>(x) / chunk::ChunkSizeX)),
+    static_cast<INT32>(std::floor(static_cast<DBL>(y) / chunk::ChunkSizeY)),
     static_cast<INT32>(std::floor(static_cast<DBL>(z) / chunk::ChunkSizeZ)));
-  chunk *NewChunkPtr = ChunkPtr;
+  chunk *NewChunkPtr = nullptr;
+
+  if (NewChunkPos == ChunkPos || !GetChunk(NewChunkPos, NewChunkPtr))
+    return;
+
   glm::ivec3 NewBlockPos(
-    x - NewChunkPos.first * (INT64)chunk::ChunkSizeX,
-    y,
-    z - NewChunkPos.second * (INT64)chunk::ChunkSizeZ);
+    x - NewChunkPos.X * (INT64)chunk::ChunkSizeX,
+    y - NewChunkPos.Y * (INT64)chunk::ChunkSizeY,
+    z - NewChunkPos.Z * (INT64)chunk::ChunkSizeZ);
 
-  if (NewChunkPos != ChunkPos || ChunkPtr == nullptr)
-  {
-    if (GetChunk(NewChunkPos, NewChunkPtr))
-    {
-      (NewChunkPtr->*UpdateFunction)(NewBlockPos);
-      NewChunkPtr->UpdateCommandBuffer();
-    }
-  }
-  else
-  {
-    (ChunkPtr->*UpdateFunction)(NewBlockPos);
-  }
+  /* Updated block is in border of neighbour chunk */
+  NewChunkPtr->SetBorderCell(Face, NewBlockPos, IsUpdatedBlockOpaque);
+
+  if (NewChunkPtr->GetBlocks().IsAir(chunk_mesher::GetIndex(NewBlockPos)))
+    return;
+
+  NewChunkPtr->MarkRowsDirty(NewBlockPos.y, NewBlockPos.y);
+  MeshRequests.wait_push(NewChunkPos);
 }
 
 /**
@@ -192,39 +479,42 @@ VOID chunks_manager::UpdateBlockSide( INT64 x, INT64 y, INT64 z,
  * \param[in, out] Normal Intersection normal
  * \return Intersection exists flag
  */
-BOOL chunks_manager::GetSelectedBlock( const glm::vec3 &Pos, const glm::vec3 &Dir, const std::pair<INT32, INT32> &PlayerChunkPos,
+BOOL chunks_manager::GetSelectedBlock( const glm::vec3 &Pos, const glm::vec3 &Dir, const CHUNK_POS &PlayerChunkPos,
                                        INT MaxSelectionDistance,
                                        glm::ivec3 &BlockPos, FLT &Near,
-                                       std::pair<INT32, INT32> &IntersectionChunkPos, glm::ivec3 &Normal )
+                                       CHUNK_POS &IntersectionChunkPos, glm::ivec3 &Normal )
 {
   BOOL IsIntersected = FALSE;
   Near = INFINITY;
 
   {
-    std::lock_guard<std::mutex> Lock(ActiveChunksMutex);
+    epoch_manager::guard Guard(Epochs);
 
-    for (INT32 ChunkX = PlayerChunkPos.first - 1; ChunkX <= PlayerChunkPos.first + 1; ChunkX++)
-      for (INT32 ChunkZ = PlayerChunkPos.second - 1; ChunkZ <= PlayerChunkPos.second + 1; ChunkZ++)
-      {
-        std::pair<INT32, INT32> ChunkPos(ChunkX, ChunkZ);
-        chunk *ChunkPtr = nullptr;
-        FLT T = INFINITY;
+    INT32 NeighbourChunksY = ENABLE_CUBIC_CHUNKS ? 1 : 0;
 
-        if (GetChunk(ChunkPos, ChunkPtr))
+    for (INT32 ChunkX = PlayerChunkPos.X - 1; ChunkX <= PlayerChunkPos.X + 1; ChunkX++)
+      for (INT32 ChunkY = PlayerChunkPos.Y - NeighbourChunksY; ChunkY <= PlayerChunkPos.Y + NeighbourChunksY; ChunkY++)
+        for (INT32 ChunkZ = PlayerChunkPos.Z - 1; ChunkZ <= PlayerChunkPos.Z + 1; ChunkZ++)
         {
-          glm::ivec3 NewNormal;
-          glm::ivec3 Res = ChunkPtr->GetSelectedBlock(Pos, Dir, MaxSelectionDistance, &T, ChunkPos, NewNormal);
+          CHUNK_POS ChunkPos(ChunkX, ChunkY, ChunkZ);
+          const chunk *ChunkPtr = GetPublishedChunk(ChunkPos);
+          FLT T = INFINITY;
 
-          if (T < MaxSelectionDistance && T < Near)
+          if (ChunkPtr != nullptr)
           {
-            IsIntersected = TRUE;
-            Near = T;
-            BlockPos = Res;
-            IntersectionChunkPos = ChunkPos;
-            Normal = NewNormal;
+            glm::ivec3 NewNormal;
+            glm::ivec3 Res = ChunkPtr->GetSelectedBlock(Pos, Dir, MaxSelectionDistance, &T, ChunkPos, NewNormal);
+
+            if (T < MaxSelectionDistance && T < Near)
+            {
+              IsIntersected = TRUE;
+              Near = T;
+              BlockPos = Res;
+              IntersectionChunkPos = ChunkPos;
+              Normal = NewNormal;
+            }
           }
         }
-      }
   }
 
   return IsIntersected;
@@ -234,181 +524,503 @@ BOOL chunks_manager::GetSelectedBlock( const glm::vec3 &Pos, const glm::vec3 &Di
  * \brief Load chunk function
  * \param[in] ChunkPos Chunk position
  */
-VOID chunks_manager::LoadChunk( const std::pair<INT32, INT32> &ChunkPos )
+VOID chunks_manager::LoadChunk( const CHUNK_POS &ChunkPos )
 {
-  chunk *ChunkPtr = nullptr;
+  CHUNK_SLOT &Slot = ActiveChunks[GetSlotIndex(ChunkPos)];
 
   {
     std::lock_guard<std::mutex> Lock(ActiveChunksMutex);
 
-    ChunkPtr = &ActiveChunks[ChunkPos];
+    /* Request was cancelled or chunk is already loaded */
+    if (Slot.State != CHUNK_STATE::REQUESTED || Slot.ChunkPos != ChunkPos)
+      return;
+
+    Slot.State = CHUNK_STATE::LOADING;
+  }
+
+  std::unique_ptr<chunk> NewChunk = std::make_unique<chunk>();
+  std::unique_ptr<chunk_blocks> NewBlocks = std::make_unique<chunk_blocks>();
 
-    if (ChunksInDrive.find(ChunkPos) == ChunksInDrive.end())
+  NewChunk->Position = ChunkPos;
+
+  if (ChunksInDrive.find(ChunkPos) == ChunksInDrive.end())
+  {
+    INT32 ChunkX = ChunkPos.X;
+    INT32 ChunkZ = ChunkPos.Z;
+    INT64 ChunkBaseY = chunk::ChunkSizeY * (INT64)ChunkPos.Y;
+
+    BLOCK Stone, Grass;
+
+    Stone.BlockTypeId = BLOCK_TYPE::StoneId;
+    Grass.BlockTypeId = BLOCK_TYPE::GrassId;
+
+    for (UINT64 z = 0; z < chunk::ChunkSizeZ; z++)
     {
-      INT32 ChunkX = ChunkPos.first;
-      INT32 ChunkZ = ChunkPos.second;
+      DBL GlobalZ = ChunkZ * chunk::ChunkSizeZ + (DBL)z;
 
-      for (UINT64 z = 0; z < chunk::ChunkSizeZ; z++)
+      for (UINT64 x = 0; x < chunk::ChunkSizeZ; x++)
       {
-        DBL GlobalZ = ChunkZ * chunk::ChunkSizeZ + (DBL)z;
+        DBL GlobalX = ChunkX * chunk::ChunkSizeX + (DBL)x;
 
-        for (UINT64 x = 0; x < chunk::ChunkSizeZ; x++)
-        {
-          DBL GlobalX = ChunkX * chunk::ChunkSizeX + (DBL)x;
+        DBL GlobalY = 15 * Noise.GetNoise(GlobalX / 2, GlobalZ / 2, 0.0) + 65;
 
-          DBL GlobalY = 15 * Noise.GetNoise(GlobalX / 2, GlobalZ / 2, 0.0) + 65;
+        /* Surface height relative to chunk bottom (cubic chunks below surface are filled, above are empty) */
+        INT64 MaxY = (INT64)GlobalY - ChunkBaseY;
 
-          UINT64 MaxY = GlobalY;
+        for (INT64 y = 0; y < std::min(MaxY, (INT64)chunk::ChunkSizeY); y++)
+          NewBlocks->Set(z * chunk::ChunkSizeY * chunk::ChunkSizeX + y * chunk::ChunkSizeX + x, Stone);
 
-          for (UINT64 y = 0; y < MaxY; y++)
-            ChunkPtr->Blocks[z * chunk::ChunkSizeY * chunk::ChunkSizeX + y * chunk::ChunkSizeX +
-                             x].BlockTypeId = BLOCK_TYPE::StoneId;
+        if (MaxY < 0 || MaxY >= chunk::ChunkSizeY)
+          continue;
 
-          BOOL IsGrassCovered = Noise.GetNoise(GlobalX * 10, GlobalZ * 10, 50.0) > -0.5;
+        BOOL IsGrassCovered = Noise.GetNoise(GlobalX * 10, GlobalZ * 10, 50.0) > -0.5;
 
-          if (IsGrassCovered)
-            ChunkPtr->Blocks[z * chunk::ChunkSizeY * chunk::ChunkSizeX + MaxY * chunk::ChunkSizeX +
-                             x].BlockTypeId = BLOCK_TYPE::GrassId;
-          else
-            ChunkPtr->Blocks[z * chunk::ChunkSizeY * chunk::ChunkSizeX + MaxY * chunk::ChunkSizeX +
-                             x].BlockTypeId = BLOCK_TYPE::StoneId;
-        }
+        NewBlocks->Set(z * chunk::ChunkSizeY * chunk::ChunkSizeX + MaxY * chunk::ChunkSizeX + x,
+                       IsGrassCovered ? Grass : Stone);
       }
     }
+
+    NewBlocks->Compact();
+  }
+  else
+  {
+    if (!std::filesystem::exists(WorldDirectory))
+      throw std::runtime_error("save directory doesn't exists");
+
+    std::vector<BYTE> DecompressedData;
+
+    ReadCompressedFile(GetChunkFileName(ChunkPos), DecompressedData);
+    NewBlocks->Load(DecompressedData.data(), DecompressedData.size());
+
+    /* Mesh saved with same blocks is reused if neighbours are same too */
+    NewChunk->MeshCache = LoadMeshCache(ChunkPos,
+                                        chunk_mesher::GetHash(DecompressedData.data(), DecompressedData.size()));
+  }
+
+  /* Chunk isn't visible for other threads yet, so its empty blocks are just replaced */
+  NewChunk->SetBlocks(std::move(NewBlocks));
+
+  {
+    std::lock_guard<std::mutex> Lock(ActiveChunksMutex);
+
+    Slot.Chunk = std::move(NewChunk);
+    Slot.State = CHUNK_STATE::READY;
+    Slot.Generation++;
+  }
+
+  MeshRequests.wait_push(ChunkPos);
+}
+
+/**
+ * \brief Build mesh of ready chunk or re-mesh dirty sections of meshed chunk function (called from meshing threads)
+ * \param[in] ChunkPos Chunk position
+ */
+VOID chunks_manager::MeshChunk( const CHUNK_POS &ChunkPos )
+{
+  CHUNK_SLOT &Slot = ActiveChunks[GetSlotIndex(ChunkPos)];
+  MESH_RESULT Result;
+  const chunk *ChunkPtr = nullptr;
+  const chunk_blocks *Blocks = nullptr;
+  std::unique_ptr<chunk_blocks> Coarse;
+  std::shared_ptr<const CHUNK_MESH_CACHE> Cache;
+
+  /* Unloaded chunk and blocks replaced by edit are deleted only after guard leaves epoch */
+  epoch_manager::guard Guard(Epochs);
+
+  {
+    std::lock_guard<std::mutex> Lock(ActiveChunksMutex);
+
+    if ((Slot.State != CHUNK_STATE::READY && Slot.State != CHUNK_STATE::MESHED) || Slot.ChunkPos != ChunkPos)
+      return;
+
+    chunk &Chunk = *Slot.Chunk;
+
+    Result.Lod = GetLod(ChunkPos);
+    Result.SkirtFaces = GetSkirtFaces(ChunkPos);
+
+    if (Slot.State == CHUNK_STATE::READY)
+    {
+      /* First mesh is full, it covers edits and starved uploads made before it */
+      Result.Sections = (1ull << chunk_blocks::NumberOfSections) - 1;
+      Chunk.DirtySections = 0;
+      GetNeighbourBorders(ChunkPos, Result.Borders);
+    }
     else
     {
-      if (!std::filesystem::exists("world"))
-        throw std::runtime_error("save directory doesn't exists");
+      /* Edits made while chunk is re-meshing are collected into next re-mesh */
+      if (Chunk.IsRemeshing)
+        return;
 
-      std::string FileName = "world/" + std::to_string(ChunkPos.first) + "," + std::to_string(ChunkPos.second) + ".chunk";
+      /* Sections of other level of detail can't be reused */
+      if (Result.Lod != Chunk.Lod || Result.SkirtFaces != Chunk.SkirtFaces)
+        Chunk.MarkRowsDirty(0, chunk::ChunkSizeY - 1);
 
-      std::ifstream File(FileName, std::ios::binary | std::ios::ate);
+      if (Chunk.DirtySections == 0)
+        return;
 
-      if (!File)
-        throw std::runtime_error("file not opened for read");
+      Result.Sections = Chunk.DirtySections;
+      Chunk.DirtySections = 0;
+      Chunk.IsRemeshing = TRUE;
 
-      INT64 Size = File.tellg();
-      std::vector<CHAR> Bytes(Size);
+      Result.Borders = Chunk.Borders;
+    }
 
-      File.seekg(std::ios::beg);
-      File.read(Bytes.data(), Size);
+    /* Edits publish new blocks instead of changing these, so mesh is built from them without lock */
+    Blocks = &Chunk.GetBlocks();
 
-      UINT32 DstDataSize = ChunkPtr->Blocks.size() * sizeof(BLOCK);
-      UINT32 DecompressedSize = DstDataSize;
+    ChunkPtr = &Chunk;
+    Cache = Chunk.MeshCache;
+    Result.Generation = Slot.Generation;
+  }
 
-      INT DecompressionRes = uncompress(
-        reinterpret_cast<Bytef *>(ChunkPtr->Blocks.data()),
-        reinterpret_cast<uLongf *>(&DecompressedSize),
-        reinterpret_cast<const Bytef *>(Bytes.data()),
-        Bytes.size() * sizeof(BYTE));
+  Result.ChunkPos = ChunkPos;
 
-      if (DecompressionRes != Z_OK || DecompressedSize != DstDataSize)
-        throw std::runtime_error("decompression error");
-    }
+  /* Border faces next to other level of detail aren't culled - they cover cracks as skirts */
+  CHUNK_BORDERS Borders = Result.Borders;
+
+  for (UINT32 Face = 0; Face < BLOCK::NumberOfFaces; Face++)
+    if ((Result.SkirtFaces >> Face) & 1)
+      Borders.Opaque[Face].clear();
+
+  Result.BordersHash = Borders.GetHash();
+
+  /* Saved mesh is built from same blocks, it is reused whole if it was culled with same borders */
+  Result.IsCached = Cache != nullptr && Result.Sections == (1ull << chunk_blocks::NumberOfSections) - 1 &&
+                    Cache->Lod == Result.Lod && Cache->BordersHash == Result.BordersHash;
+
+  if (Result.IsCached)
+    Result.SectionQuads = Cache->SectionQuads;
+  else if (Result.Lod > 0)
+  {
+    Coarse = std::make_unique<chunk_blocks>();
+
+    chunk_mesher::Downsample(*Blocks, Result.Lod, *Coarse);
+    Blocks = Coarse.get();
   }
 
-  ChunkPtr->CreateGeometry(Render, ChunkPos);
+  for (UINT32 SectionId = 0; SectionId < chunk_blocks::NumberOfSections; SectionId++)
+    if (!Result.IsCached && ((Result.Sections >> SectionId) & 1))
+      chunk_mesher::BuildSectionQuads(*Blocks, Borders, SectionId, Result.SectionQuads[SectionId],
+                                      Result.Lod > 0 || ENABLE_GREEDY_MESHING);
+
+  /* Quads of clean sections are changed only by upload of this re-mesh */
+  for (UINT32 SectionId = 0; SectionId < chunk_blocks::NumberOfSections; SectionId++)
+    chunk_mesher::AddQuads(Result.Mesh, ((Result.Sections >> SectionId) & 1) ? Result.SectionQuads[SectionId] :
+                           ChunkPtr->SectionQuads[SectionId], ChunkPos);
+
+  MeshResults.wait_push(std::move(Result));
 }
 
 /**
- * \brief Unload chunk function
- * \param[in] ChunkPos Chunk position
+ * \brief Upload chunk mesh to render and swap it with old geometry function (called from upload thread)
+ * \param[in, out] Result Built chunk mesh (section quads are moved to chunk)
  */
-VOID chunks_manager::UnloadChunk( const std::pair<INT32, INT32> &ChunkPos )
+VOID chunks_manager::UploadChunk( MESH_RESULT &Result )
 {
+  CHUNK_SLOT &Slot = ActiveChunks[GetSlotIndex(Result.ChunkPos)];
+
+  /* Geometry isn't drawn until swap, so it is created without lock */
+  std::unique_ptr<chunk_geometry> Geometry;
+  UINT64 VertexOffset = 0;
+  std::optional<UINT32> VertexRangeId =
+    Render.MemoryManager.AllocateVertices(chunk_geometry::GetVertexRangeSize(Result.Mesh), VertexOffset);
+
+  if (VertexRangeId)
+    Geometry = std::make_unique<chunk_geometry>(Render, Result.Mesh, Result.ChunkPos, *VertexRangeId, VertexOffset);
+
   std::lock_guard<std::mutex> Lock(ActiveChunksMutex);
-  std::map<std::pair<INT32, INT32>, chunk>::iterator It = ActiveChunks.find(ChunkPos);
 
-  if (It == ActiveChunks.end())
+  /* Chunk was unloaded while mesh was building - new geometry is dropped */
+  if ((Slot.State != CHUNK_STATE::READY && Slot.State != CHUNK_STATE::MESHED) || Slot.ChunkPos != Result.ChunkPos ||
+      Slot.Generation != Result.Generation)
   {
-    //throw std::runtime_error("chunk doesn't exists");
-    std::cout << "chunk doesn't exists (mb it's not good)\n" << std::endl;
+    if (Geometry != nullptr)
+    {
+      Geometry = nullptr;
+      RequeueStarvedChunks();
+    }
     return;
   }
-  
-  if (!std::filesystem::exists("world"))
-    std::filesystem::create_directory("world");
 
-  std::string FileName = "world/" + std::to_string(ChunkPos.first) + "," + std::to_string(ChunkPos.second) + ".chunk";
+  chunk &Chunk = *Slot.Chunk;
 
-  std::ofstream File(FileName, std::ios::binary);
+  /* Vertex buffer is full - old geometry stays drawn, mesh is rebuilt after some range is freed */
+  if (Geometry == nullptr)
+  {
+    Chunk.DirtySections |= Result.Sections;
+    Chunk.IsRemeshing = FALSE;
+    StarvedChunks.insert(Chunk.Position);
+    return;
+  }
 
-  if (!File)
-    throw std::runtime_error("file not opened for write");
+  Chunk.SetGeometry(Render, std::move(Geometry));
+  RequeueStarvedChunks();
+  Chunk.Lod = Result.Lod;
+  Chunk.SkirtFaces = Result.SkirtFaces;
+  Chunk.BordersHash = Result.BordersHash;
 
-  UINT32 SrcDataSize = It->second.Blocks.size() * sizeof(BLOCK);
+  /* Saved mesh is reused once, its quads are in chunk now */
+  if (Result.IsCached)
+    Chunk.MeshCache = nullptr;
 
-  UINT32 MaxDstDataSize = compressBound(SrcDataSize);
-  UINT32 DstDataSize = MaxDstDataSize;
+  for (UINT32 SectionId = 0; SectionId < chunk_blocks::NumberOfSections; SectionId++)
+    if ((Result.Sections >> SectionId) & 1)
+      Chunk.SectionQuads[SectionId] = std::move(Result.SectionQuads[SectionId]);
 
-  std::vector<BYTE> CompressedData(MaxDstDataSize);
+  if (Slot.State == CHUNK_STATE::READY)
+  {
+    Slot.State = CHUNK_STATE::MESHED;
+    Slot.Published.store(&Chunk);
 
-  INT CompressionRes = compress(reinterpret_cast<Bytef *>(CompressedData.data()),
-    reinterpret_cast<uLongf *>(&DstDataSize),
-    reinterpret_cast<const Bytef *>(It->second.Blocks.data()),
-    SrcDataSize);
+    /* Neighbours could be loaded, unloaded or edited while mesh was building */
+    CHUNK_BORDERS Borders;
 
-  if (CompressionRes != Z_OK)
-    throw std::runtime_error("compression error");
+    Chunk.Borders = std::move(Result.Borders);
+    GetNeighbourBorders(Chunk.Position, Borders);
 
-  File.write(reinterpret_cast<const CHAR *>(CompressedData.data()), DstDataSize);
+    for (UINT32 Face = 0; Face < BLOCK::NumberOfFaces; Face++)
+      Chunk.SetBorder(Face, std::move(Borders.Opaque[Face]));
 
-  ChunksInDrive.insert(ChunkPos);
+    UpdateNeighbourBorders(Chunk, TRUE);
+  }
+
+  Chunk.IsRemeshing = FALSE;
+
+  /* Player could move to other level of detail while mesh was building */
+  if (Result.Lod != GetLod(Chunk.Position) || Result.SkirtFaces != GetSkirtFaces(Chunk.Position))
+    Chunk.MarkRowsDirty(0, chunk::ChunkSizeY - 1);
 
-  ActiveChunks.erase(ChunkPos);
+  if (Chunk.DirtySections != 0)
+    MeshRequests.wait_push(Chunk.Position);
 }
 
 /**
- * \brief Set current central chunk in active function
- * \param[in] CurrentChunk Current chunk
+ * \brief Get neighbour chunk position function
+ * \param[in] ChunkPos Chunk position
+ * \param[in] Face Direction to neighbour (BLOCK::Face* constant)
+ * \return Neighbour chunk position
  */
-VOID chunks_manager::SetCurrentChunk( const std::pair<INT32, INT32> &CurrentChunk )
+CHUNK_POS chunks_manager::GetNeighbourPos( const CHUNK_POS &ChunkPos, UINT32 Face )
 {
-  if (CurrentChunk == CurrentCentralChunk)
-    return;
+  const glm::ivec3 &Normal = BLOCK::FaceNormals[Face];
 
-  CurrentCentralChunk = CurrentChunk;
+  return CHUNK_POS(ChunkPos.X + Normal.x, ChunkPos.Y + Normal.y, ChunkPos.Z + Normal.z);
+}
 
-  INT32 FirstXChunk = CurrentChunk.first - RenderDistance;
-  INT32 LastXChunk = CurrentChunk.first + RenderDistance;
-  INT32 FirstYChunk = CurrentChunk.second - RenderDistance;
-  INT32 LastYChunk = CurrentChunk.second + RenderDistance;
+/**
+ * \brief Get borders of meshed neighbours function (active chunks mutex must be locked)
+ * \param[in] ChunkPos Chunk position
+ * \param[out] Borders Neighbour borders (empty for not meshed neighbours)
+ */
+VOID chunks_manager::GetNeighbourBorders( const CHUNK_POS &ChunkPos, CHUNK_BORDERS &Borders )
+{
+  for (UINT32 Face = 0; Face < BLOCK::NumberOfFaces; Face++)
+  {
+    chunk *Neighbour = nullptr;
 
+    if (GetChunk(GetNeighbourPos(ChunkPos, Face), Neighbour))
+      chunk_mesher::GetBorder(Neighbour->GetBlocks(), Face, Borders.Opaque[Face]);
+    else
+      Borders.Opaque[Face].clear();
+  }
+}
+
+/**
+ * \brief Update borders of meshed neighbours and request their re-mesh function (active chunks mutex must be locked)
+ * \param[in] Chunk Loaded or unloaded chunk
+ * \param[in] IsLoaded Chunk is loaded flag (FALSE - neighbours border faces are restored)
+ */
+VOID chunks_manager::UpdateNeighbourBorders( const chunk &Chunk, BOOL IsLoaded )
+{
+  for (UINT32 Face = 0; Face < BLOCK::NumberOfFaces; Face++)
   {
-    std::lock_guard<std::mutex> Lock(ActiveChunksMutex);
+    CHUNK_POS NeighbourPos = GetNeighbourPos(Chunk.Position, Face);
+    chunk *Neighbour = nullptr;
 
-    for (const auto &[Pos, Chunk] : ActiveChunks)
-      if (Pos.first < FirstXChunk || Pos.first > LastXChunk ||
-          Pos.second < FirstYChunk || Pos.second > LastYChunk)
-      {
-        CHUNK_REQUEST Request = {CHUNK_REQUEST::OPERATION_TYPE::UNLOAD, Pos};
+    if (!GetChunk(NeighbourPos, Neighbour))
+      continue;
 
-        ChunkRequests.wait_push(Request);
-      }
+    /* Neighbour sees chunk in opposite direction */
+    std::vector<UINT64> Border;
+
+    if (IsLoaded)
+      chunk_mesher::GetBorder(Chunk.GetBlocks(), Face ^ 1, Border);
+
+    if (Neighbour->SetBorder(Face ^ 1, std::move(Border)))
+      MeshRequests.wait_push(NeighbourPos);
   }
+}
+
+/**
+ * \brief Unload chunk function
+ * \param[in] ChunkPos Chunk position
+ */
+VOID chunks_manager::UnloadChunk( const CHUNK_POS &ChunkPos )
+{
+  CHUNK_SLOT &Slot = ActiveChunks[GetSlotIndex(ChunkPos)];
+  std::unique_ptr<chunk> OldChunk;
+  BOOL IsMeshClean = FALSE;
+
+  {
+    std::lock_guard<std::mutex> Lock(ActiveChunksMutex);
 
-  for (INT32 ChunkZ = FirstYChunk; ChunkZ <= LastYChunk; ChunkZ++)
-    for (INT32 ChunkX = FirstXChunk; ChunkX <= LastXChunk; ChunkX++)
+    /* Ready chunk is unloaded without geometry, its mesh is dropped by upload thread */
+    if ((Slot.State != CHUNK_STATE::MESHED && Slot.State != CHUNK_STATE::READY) || Slot.ChunkPos != ChunkPos)
     {
-      std::pair<INT32, INT32> ChunkPos(ChunkX, ChunkZ);
+      //throw std::runtime_error("chunk doesn't exists");
+      std::cout << "chunk doesn't exists (mb it's not good)\n" << std::endl;
+      return;
+    }
 
-      std::map<std::pair<INT32, INT32>, chunk>::iterator It;
+    /* Only meshed chunk is in borders of its neighbours */
+    if (Slot.State == CHUNK_STATE::MESHED)
+      UpdateNeighbourBorders(*Slot.Chunk, FALSE);
 
-      {
-        std::lock_guard<std::mutex> Lock(ActiveChunksMutex);
+    /* Geometry matches blocks only if no edit is waiting for re-mesh */
+    IsMeshClean = Slot.State == CHUNK_STATE::MESHED && Slot.Chunk->DirtySections == 0 && !Slot.Chunk->IsRemeshing;
+
+    Slot.State = CHUNK_STATE::UNLOADING;
+    Slot.Published.store(nullptr);
+    OldChunk = std::move(Slot.Chunk);
+  }
 
-        It = ActiveChunks.find(ChunkPos);
+  if (!std::filesystem::exists(WorldDirectory))
+    std::filesystem::create_directory(WorldDirectory);
 
-        if (It == ActiveChunks.end())
-          ActiveChunks[ChunkPos];
-      }
+  std::vector<BYTE> SrcData;
+
+  OldChunk->GetBlocks().Save(SrcData);
+  WriteCompressedFile(GetChunkFileName(ChunkPos), SrcData);
 
-      if (It == ActiveChunks.end())
+  /* Mesh is saved next to blocks and keyed by their hash (mesh loaded with not edited blocks stays valid) */
+  std::string MeshFileName = GetChunkFileName(ChunkPos, ".mesh");
+
+  if (IsMeshClean)
+  {
+    CHUNK_MESH_CACHE Cache;
+    std::vector<BYTE> MeshData;
+
+    Cache.BlocksHash = chunk_mesher::GetHash(SrcData.data(), SrcData.size());
+    Cache.Lod = OldChunk->Lod;
+    Cache.BordersHash = OldChunk->BordersHash;
+
+    /* Meshing threads can still read section quads of unloaded chunk, so they are copied */
+    Cache.SectionQuads = OldChunk->SectionQuads;
+    Cache.Save(MeshData);
+    WriteCompressedFile(MeshFileName, MeshData);
+  }
+  else if (OldChunk->MeshCache == nullptr && std::filesystem::exists(MeshFileName))
+    std::filesystem::remove(MeshFileName);
+
+  ChunksInDrive.insert(ChunkPos);
+
+  /* Lock-free readers may still use chunk blocks - delete chunk after they leave epoch */
+  OldChunk->SetGeometry(Render, nullptr);
+  Epochs.Retire([Chunk = OldChunk.release()]( VOID )
+  {
+    delete Chunk;
+  });
+
+  std::lock_guard<std::mutex> Lock(ActiveChunksMutex);
+
+  /* Freed vertex range may fit meshes which didn't fit before */
+  RequeueStarvedChunks();
+
+  /* Slot could be reserved for other chunk while this one was unloading */
+  if (Slot.IsReserved)
+  {
+    Slot.ChunkPos = Slot.ReservedPos;
+    Slot.State = CHUNK_STATE::REQUESTED;
+  }
+  else
+    Slot.State = CHUNK_STATE::FREE;
+}
+
+/**
+ * \brief Push meshing requests of chunks which didn't fit vertex buffer function (active chunks mutex must be locked)
+ */
+VOID chunks_manager::RequeueStarvedChunks( VOID )
+{
+  /* Unloaded chunks are skipped by meshing threads */
+  for (const CHUNK_POS &ChunkPos : StarvedChunks)
+    MeshRequests.wait_push(ChunkPos);
+
+  StarvedChunks.clear();
+}
+
+/**
+ * \brief Release slot reservation function (active chunks mutex must be locked)
+ * \param[in, out] Slot Active chunks grid slot
+ */
+VOID chunks_manager::ReleaseSlot( CHUNK_SLOT &Slot )
+{
+  Slot.IsReserved = FALSE;
+
+  /* Load request for other chunk in slot is still queued - it will be skipped */
+  if (Slot.ChunkPos != Slot.ReservedPos || Slot.State == CHUNK_STATE::UNLOADING)
+    return;
+
+  /* Chunk is not loading yet - cancel request */
+  if (Slot.State == CHUNK_STATE::REQUESTED)
+  {
+    Slot.State = CHUNK_STATE::FREE;
+    return;
+  }
+
+  CHUNK_REQUEST Request = {CHUNK_REQUEST::OPERATION_TYPE::UNLOAD, Slot.ReservedPos};
+
+  ChunkRequests.wait_push(Request);
+}
+
+/**
+ * \brief Set current central chunk in active function
+ * \param[in] CurrentChunk Current chunk
+ */
+VOID chunks_manager::SetCurrentChunk( const CHUNK_POS &CurrentChunk )
+{
+  /* Meshing threads read central chunk for levels of detail */
+  std::lock_guard<std::mutex> Lock(ActiveChunksMutex);
+
+  if (CurrentChunk == CurrentCentralChunk)
+    return;
+
+  CurrentCentralChunk = CurrentChunk;
+
+  /* Requests are processed in order, so unloading of old chunk in slot is done before loading of new one */
+  for (CHUNK_SLOT &Slot : ActiveChunks)
+    if (Slot.IsReserved && !IsInWindow(Slot.ReservedPos, CurrentChunk))
+      ReleaseSlot(Slot);
+
+  for (INT32 ChunkZ = CurrentChunk.Z - RenderDistance; ChunkZ <= CurrentChunk.Z + RenderDistance; ChunkZ++)
+    for (INT32 ChunkY = CurrentChunk.Y - VerticalRenderDistance; ChunkY <= CurrentChunk.Y + VerticalRenderDistance; ChunkY++)
+      for (INT32 ChunkX = CurrentChunk.X - RenderDistance; ChunkX <= CurrentChunk.X + RenderDistance; ChunkX++)
       {
-        CHUNK_REQUEST Request = {CHUNK_REQUEST::OPERATION_TYPE::LOAD, ChunkPos};
+        CHUNK_POS ChunkPos(ChunkX, ChunkY, ChunkZ);
+        CHUNK_SLOT &Slot = ActiveChunks[GetSlotIndex(ChunkPos)];
+
+        if (!Slot.IsReserved)
+        {
+          CHUNK_REQUEST Request = {CHUNK_REQUEST::OPERATION_TYPE::LOAD, ChunkPos};
 
-        ChunkRequests.wait_push(Request);
+          ChunkRequests.wait_push(Request);
+          Slot.ReservedPos = ChunkPos;
+          Slot.IsReserved = TRUE;
+
+          if (Slot.State == CHUNK_STATE::FREE)
+          {
+            Slot.ChunkPos = ChunkPos;
+            Slot.State = CHUNK_STATE::REQUESTED;
+          }
+        }
       }
+
+  /* Chunks which changed level of detail (or got neighbours of other level) are re-meshed whole */
+  for (CHUNK_SLOT &Slot : ActiveChunks)
+    if (Slot.State == CHUNK_STATE::MESHED &&
+        (Slot.Chunk->Lod != GetLod(Slot.ChunkPos) || Slot.Chunk->SkirtFaces != GetSkirtFaces(Slot.ChunkPos)))
+    {
+      Slot.Chunk->MarkRowsDirty(0, chunk::ChunkSizeY - 1);
+      MeshRequests.wait_push(Slot.ChunkPos);
     }
 }
 
@@ -417,11 +1029,12 @@ VOID chunks_manager::SetCurrentChunk( const std::pair<INT32, INT32> &CurrentChun
  */
 chunks_manager::~chunks_manager( VOID )
 {
-  for (const auto &[Pos, Chunk] : ActiveChunks)
   {
-    CHUNK_REQUEST Request = {CHUNK_REQUEST::OPERATION_TYPE::UNLOAD, Pos};
+    std::lock_guard<std::mutex> Lock(ActiveChunksMutex);
 
-    ChunkRequests.wait_push(Request);
+    for (CHUNK_SLOT &Slot : ActiveChunks)
+      if (Slot.IsReserved)
+        ReleaseSlot(Slot);
   }
 
   ExitFlag.store(TRUE, std::memory_order_seq_cst);
@@ -429,13 +1042,23 @@ chunks_manager::~chunks_manager( VOID )
   ChunksControllerThread.wait();
   ChunksLoaderThread.wait();
 
-  if (!std::filesystem::exists("world"))
-    std::filesystem::create_directory("world");
+  /* Loader thread doesn't push meshing requests anymore, meshing threads don't push meshes */
+  MeshRequests.close();
+
+  for (std::future<VOID> &MeshingThread : MeshingThreads)
+    MeshingThread.wait();
+
+  MeshResults.close();
+  UploadThread.wait();
+
+  if (!std::filesystem::exists(WorldDirectory))
+    std::filesystem::create_directory(WorldDirectory);
 
-  if (std::filesystem::exists("world/saved.txt"))
-    std::filesystem::remove("world/saved.txt");
+  std::string FileName = std::string(WorldDirectory) + "/saved.txt";
+
+  if (std::filesystem::exists(FileName))
+    std::filesystem::remove(FileName);
 
-  std::string FileName = "world/saved.txt";
   std::ofstream File(FileName);
 
   if (!File)
@@ -444,7 +1067,14 @@ chunks_manager::~chunks_manager( VOID )
     return; //throw std::runtime_error("file not opened");
   }
 
-  for (const std::pair<INT32, INT32> &Pos : ChunksInDrive)
-    File << Pos.first << " " << Pos.second << "\n";
+  for (const CHUNK_POS &Pos : ChunksInDrive)
+  {
+    File << Pos.X << " ";
+
+    if (ENABLE_CUBIC_CHUNKS)
+      File << Pos.Y << " ";
+
+    File << Pos.Z << "\n";
+  }
 }
 
@@ -1,7 +1,10 @@
 #ifndef __chunks_manager_h_
 #define __chunks_manager_h_
 
-#include <map>
+#include <set>
+#include <string>
+#include <vector>
+#include <array>
 #include <boost/thread/sync_queue.hpp>
 #include <atomic>
 #include <mutex>
@@ -10,6 +13,7 @@
 
 #include "chunk.h"
 #include "render/render.h"
+#include "utils/epoch_manager.h"
 
 class player;
 
@@ -23,15 +27,20 @@ public:
    * \brief Chunks manager constructor
    * \param[in, out] Render Render object
    * \param[in] RenderDistance Render distance in chunks
+   * \param[in] VerticalRenderDistance Vertical render distance in chunks (ignored without cubic chunks)
+   * \param[in] LodDistances Distances in chunks beyond which chunks are meshed with next level of detail
    * \param[in] Player Reference to player
+   * \param[in] NumberOfMeshingThreads Number of chunk meshing threads (0 - number of hardware threads without one)
    */
-  chunks_manager( render &Render, INT RenderDistance, player &Player );
+  chunks_manager( render &Render, INT RenderDistance, INT VerticalRenderDistance,
+                  const std::array<INT, chunk_mesher::NumberOfLods - 1> &LodDistances, player &Player,
+                  UINT32 NumberOfMeshingThreads = 0 );
 
   /**
    * \brief Set current central chunk in active function
    * \param[in] CurrentChunk Current chunk
    */
-  VOID SetCurrentChunk( const std::pair<INT32, INT32> &CurrentChunk );
+  VOID SetCurrentChunk( const CHUNK_POS &CurrentChunk );
 
   /**
    * \brief Chunks manager destructor
@@ -50,14 +59,35 @@ public:
    * \param[in, out] ChunkPtr Reference to pointer to chunk
    * \return Chunk exists flag
    */
-  BOOL GetChunk( const std::pair<INT32, INT32> &ChunkPos, chunk *&ChunkPtr );
+  BOOL GetChunk( const CHUNK_POS &ChunkPos, chunk *&ChunkPtr );
 
   /**
-   * \brief Update block geometry
+   * \brief Get epoch manager for lock-free chunk readers function
+   * \return Reference to epoch manager
+   */
+  epoch_manager & GetEpochManager( VOID );
+
+  /**
+   * \brief Get published chunk without locking function (must be called inside epoch guard)
+   * \param[in] ChunkPos Chunk position
+   * \return Pointer to chunk (valid until guard leaves epoch) or nullptr if chunk isn't loaded
+   */
+  const chunk * GetPublishedChunk( const CHUNK_POS &ChunkPos ) const;
+
+  /**
+   * \brief Set block of meshed chunk and request re-mesh function (active chunks mutex must be locked)
    * \param[in] ChunkPos Chunk position
    * \param[in] BlockPos Block position
+   * \param[in] Block New block
    */
-  VOID UpdateBlock( const std::pair<INT32, INT32> &ChunkPos, const glm::ivec3 &BlockPos );
+  VOID SetBlock( const CHUNK_POS &ChunkPos, const glm::ivec3 &BlockPos, const BLOCK &Block );
+
+  /**
+   * \brief Mark block sections as dirty and request re-mesh function (active chunks mutex must be locked)
+   * \param[in] ChunkPos Chunk position
+   * \param[in] BlockPos Block position
+   */
+  VOID UpdateBlock( const CHUNK_POS &ChunkPos, const glm::ivec3 &BlockPos );
 
   /**
    * \brief Get selected block function
@@ -71,47 +101,240 @@ public:
    * \param[in, out] Normal Intersection normal
    * \return Intersection exists flag
    */
-  BOOL GetSelectedBlock( const glm::vec3 &Pos, const glm::vec3 &Dir, const std::pair<INT32, INT32> &PlayerChunkPos,
+  BOOL GetSelectedBlock( const glm::vec3 &Pos, const glm::vec3 &Dir, const CHUNK_POS &PlayerChunkPos,
                          INT MaxSelectionDistance,
                          glm::ivec3 &BlockPos, FLT &Near,
-                         std::pair<INT32, INT32> &IntersectionChunkPos, glm::ivec3 &Normal );
+                         CHUNK_POS &IntersectionChunkPos, glm::ivec3 &Normal );
 
 private:
   /**
-   * \brief Update block side
+   * \brief Update block side in neighbour chunk (sides in same chunk are re-meshed with block section)
    * \param[in] x Block x-coordinate
    * \param[in] y Block y-coordinate
    * \param[in] z Block z-coordinate
-   * \param[in] ChunkPos Loaded chunk position
-   * \param[in, out] ChunkPtr Pointer to chunk
-   * \param[in] UpdateFunction Update block side function
+   * \param[in] ChunkPos Updated block chunk position
+   * \param[in] Face Updated side (BLOCK::Face* constant)
+   * \param[in] IsUpdatedBlockOpaque Updated block is opaque flag (for neighbour chunk border)
    */
-  VOID UpdateBlockSide( INT64 x, INT64 y, INT64 z,
-                        const std::pair<INT32, INT32> &ChunkPos,
-                        chunk *ChunkPtr,
-                        VOID (chunk::*UpdateFunction)( const glm::ivec3 &BlockPos ) );
+  VOID UpdateBlockSide( INT64 x, INT64 y, INT64 z, const CHUNK_POS &ChunkPos, UINT32 Face,
+                        BOOL IsUpdatedBlockOpaque );
+
+  /**
+   * \brief Get neighbour chunk position function
+   * \param[in] ChunkPos Chunk position
+   * \param[in] Face Direction to neighbour (BLOCK::Face* constant)
+   * \return Neighbour chunk position
+   */
+  static CHUNK_POS GetNeighbourPos( const CHUNK_POS &ChunkPos, UINT32 Face );
+
+  /**
+   * \brief Get borders of meshed neighbours function (active chunks mutex must be locked)
+   * \param[in] ChunkPos Chunk position
+   * \param[out] Borders Neighbour borders (empty for not meshed neighbours)
+   */
+  VOID GetNeighbourBorders( const CHUNK_POS &ChunkPos, CHUNK_BORDERS &Borders );
+
+  /**
+   * \brief Update borders of meshed neighbours and request their re-mesh function (active chunks mutex must be locked)
+   * \param[in] Chunk Loaded or unloaded chunk
+   * \param[in] IsLoaded Chunk is loaded flag (FALSE - neighbours border faces are restored)
+   */
+  VOID UpdateNeighbourBorders( const chunk &Chunk, BOOL IsLoaded );
 
   /**
    * \brief Load chunk function
    * \param[in] ChunkPos Chunk position
    */
-  VOID LoadChunk( const std::pair<INT32, INT32> &ChunkPos );
+  VOID LoadChunk( const CHUNK_POS &ChunkPos );
 
   /**
    * \brief Unload chunk function
    * \param[in] ChunkPos Chunk position
    */
-  VOID UnloadChunk( const std::pair<INT32, INT32> &ChunkPos );
+  VOID UnloadChunk( const CHUNK_POS &ChunkPos );
+
+  /**
+   * \brief Build mesh of ready chunk or re-mesh dirty sections of meshed chunk function (called from meshing threads)
+   * \param[in] ChunkPos Chunk position
+   */
+  VOID MeshChunk( const CHUNK_POS &ChunkPos );
 
-  /** Current central chunk in active */
-  std::pair<INT32, INT32> CurrentCentralChunk = std::pair<INT32, INT32>(-1, -1);
+  /**
+   * \brief Get active chunks grid slot index function
+   * \param[in] ChunkPos Chunk position
+   * \return Slot index (chunk position modulo grid size)
+   */
+  UINT32 GetSlotIndex( const CHUNK_POS &ChunkPos ) const;
+
+  /**
+   * \brief Check if chunk position is in active window function
+   * \param[in] ChunkPos Chunk position
+   * \param[in] CentralChunk Window central chunk
+   * \return TRUE-if chunk is in window, FALSE-if otherwise
+   */
+  BOOL IsInWindow( const CHUNK_POS &ChunkPos, const CHUNK_POS &CentralChunk ) const;
 
-  /** Active chunks */
-  std::map<std::pair<INT32, INT32>, chunk> ActiveChunks;
+  /**
+   * \brief Get level of detail of chunk function (active chunks mutex must be locked)
+   * \param[in] ChunkPos Chunk position
+   * \return Level of detail by distance to current central chunk
+   */
+  UINT32 GetLod( const CHUNK_POS &ChunkPos ) const;
+
+  /**
+   * \brief Get skirt faces of chunk function (active chunks mutex must be locked)
+   *
+   * Border faces of skirt directions aren't culled by neighbour, they hide cracks between levels of detail.
+   * \param[in] ChunkPos Chunk position
+   * \return Faces mask (bit i is set for face direction i)
+   */
+  UINT32 GetSkirtFaces( const CHUNK_POS &ChunkPos ) const;
+
+  /**
+   * \brief Get chunk save file name function
+   * \param[in] ChunkPos Chunk position
+   * \param[in] Extension File extension (".chunk" - blocks, ".mesh" - mesh cache)
+   * \return File name
+   */
+  static std::string GetChunkFileName( const CHUNK_POS &ChunkPos, const CHAR *Extension = ".chunk" );
+
+  /**
+   * \brief Write compressed data to file function
+   * \param[in] FileName File name
+   * \param[in] Data Uncompressed data
+   */
+  static VOID WriteCompressedFile( const std::string &FileName, const std::vector<BYTE> &Data );
+
+  /**
+   * \brief Read compressed data from file function
+   * \param[in] FileName File name
+   * \param[out] Data Uncompressed data
+   */
+  static VOID ReadCompressedFile( const std::string &FileName, std::vector<BYTE> &Data );
+
+  /**
+   * \brief Load mesh saved with chunk function
+   * \param[in] ChunkPos Chunk position
+   * \param[in] BlocksHash Hash of loaded blocks data
+   * \return Saved mesh or nullptr if it is missing, corrupted or was built from other blocks
+   */
+  static std::shared_ptr<const CHUNK_MESH_CACHE> LoadMeshCache( const CHUNK_POS &ChunkPos, UINT64 BlocksHash );
+
+  /** Directory for world saves (cubic and column worlds aren't compatible) */
+  static constexpr const CHAR *WorldDirectory = ENABLE_CUBIC_CHUNKS ? "world_cubic" : "world";
+
+  /** Current central chunk in active (changed under active chunks mutex) */
+  CHUNK_POS CurrentCentralChunk = CHUNK_POS(-1, -1, -1);
+
+  /** Active chunk state enumeration */
+  enum class CHUNK_STATE
+  {
+    FREE,      // Slot doesn't contain chunk
+    REQUESTED, // Load of chunk is requested
+    LOADING,   // Chunk blocks are generated or read from drive (not published)
+    READY,     // Chunk blocks are published in slot, mesh is building
+    MESHED,    // Chunk is available for other threads
+    UNLOADING  // Chunk is removed from slot and is saving to drive
+  };
+
+  /**
+   * \brief Active chunks grid slot
+   */
+  struct CHUNK_SLOT
+  {
+    /** Position slot is reserved for (load requested) */
+    CHUNK_POS ReservedPos;
+
+    /** Slot is reserved flag */
+    BOOL IsReserved = FALSE;
+
+    /** Position of chunk in slot */
+    CHUNK_POS ChunkPos;
+
+    /** State of chunk in slot */
+    CHUNK_STATE State = CHUNK_STATE::FREE;
+
+    /** Number of chunks loaded in slot (meshes of previous chunks are dropped) */
+    UINT64 Generation = 0;
+
+    /** Chunk (nullptr until chunk is ready) */
+    std::unique_ptr<chunk> Chunk;
+
+    /** Chunk for lock-free readers (nullptr if chunk isn't meshed) */
+    std::atomic<const chunk *> Published = nullptr;
+  };
+
+  /**
+   * \brief Built chunk mesh waiting for upload
+   */
+  struct MESH_RESULT
+  {
+    /** Chunk position */
+    CHUNK_POS ChunkPos;
+
+    /** Slot generation mesh was built for (mesh is dropped if slot contains other chunk) */
+    UINT64 Generation = 0;
+
+    /** Level of detail mesh was built with */
+    UINT32 Lod = 0;
+
+    /** Skirt faces mesh was built with */
+    UINT32 SkirtFaces = 0;
+
+    /** Hash of borders mesh was culled with */
+    UINT64 BordersHash = 0;
+
+    /** Section quads are taken from saved mesh flag */
+    BOOL IsCached = FALSE;
+
+    /** Re-meshed sections (bit i - section i, all sections for ready chunk) */
+    UINT32 Sections = 0;
+
+    /** Quads of re-meshed sections */
+    std::array<std::vector<chunk_mesher::QUAD>, chunk_blocks::NumberOfSections> SectionQuads;
+
+    /** Neighbour borders mesh was built with */
+    CHUNK_BORDERS Borders;
+
+    /** Whole chunk mesh (re-meshed sections and quads of other sections) */
+    CHUNK_MESH Mesh;
+  };
+
+  /**
+   * \brief Upload chunk mesh to render and swap it with old geometry function (called from upload thread)
+   * \param[in, out] Result Built chunk mesh (section quads are moved to chunk)
+   */
+  VOID UploadChunk( MESH_RESULT &Result );
+
+  /**
+   * \brief Release slot reservation function (active chunks mutex must be locked)
+   * \param[in, out] Slot Active chunks grid slot
+   */
+  VOID ReleaseSlot( CHUNK_SLOT &Slot );
+
+  /**
+   * \brief Push meshing requests of chunks which didn't fit vertex buffer function (active chunks mutex must be locked)
+   */
+  VOID RequeueStarvedChunks( VOID );
 
   /** Render distance */
   INT RenderDistance;
 
+  /** Vertical render distance (0 without cubic chunks) */
+  INT VerticalRenderDistance;
+
+  /** Distances beyond which chunks are meshed with next level of detail */
+  std::array<INT, chunk_mesher::NumberOfLods - 1> LodDistances;
+
+  /** Active chunks grid size (2 * RenderDistance + 1) */
+  INT32 GridSize;
+
+  /** Active chunks grid vertical size (2 * VerticalRenderDistance + 1) */
+  INT32 GridSizeY;
+
+  /** Active chunks grid (toroidal, GridSize x GridSizeY x GridSize slots indexed by chunk position modulo grid size) */
+  std::vector<CHUNK_SLOT> ActiveChunks;
+
   /** Reference to render */
   render &Render;
 
@@ -134,7 +357,7 @@ private:
     OPERATION_TYPE OperationType;
 
     /** Chunk position */
-    std::pair<INT32, INT32> ChunkPos;
+    CHUNK_POS ChunkPos;
   };
 
   /** Chunk requests queue */
@@ -143,18 +366,36 @@ private:
   /** Exit flag */
   std::atomic<BOOL> ExitFlag;
 
-  /** Mutex for active chunks */
+  /** Ready and dirty chunks meshing requests queue */
+  boost::concurrent::sync_queue<CHUNK_POS> MeshRequests;
+
+  /** Built meshes queue (processed by single upload thread) */
+  boost::concurrent::sync_queue<MESH_RESULT> MeshResults;
+
+  /** Mutex for active chunks (writers and block edits) */
   std::mutex ActiveChunksMutex;
 
+  /** Epoch manager for unloaded chunks reclamation */
+  epoch_manager Epochs;
+
   /** Chunks in drive */
-  std::set<std::pair<INT32, INT32>> ChunksInDrive;
+  std::set<CHUNK_POS> ChunksInDrive;
+
+  /** Chunks whose mesh didn't fit vertex buffer (re-meshed after some range is freed, changed under active chunks mutex) */
+  std::set<CHUNK_POS> StarvedChunks;
 
   /** Chunks loader thread future */
   std::future<VOID> ChunksLoaderThread;
 
-  /** Chunks loader thread future */
+  /** Chunks controller thread future */
   std::future<VOID> ChunksControllerThread;
 
+  /** Chunks meshing threads futures */
+  std::vector<std::future<VOID>> MeshingThreads;
+
+  /** Chunks geometry upload thread future */
+  std::future<VOID> UploadThread;
+
   /** Reference to player */
   player &Player;
 
@@ -157,7 +157,7 @@ VOID player::SetBlock( VOID )
 {
   if (ChunksManager != nullptr)
   {
-    std::pair<INT32, INT32> PlayerChunkPos = GetCurrentChunk();
+    CHUNK_POS PlayerChunkPos = GetCurrentChunk();
     glm::vec3 Pos;
 
     {
@@ -168,7 +168,7 @@ VOID player::SetBlock( VOID )
 
     glm::ivec3 BlockPos(0, 0, 0);
     FLT Near = INFINITY;
-    std::pair<INT32, INT32> IntersectionChunkPos;
+    CHUNK_POS IntersectionChunkPos;
     glm::ivec3 Normal(0, 0, 0);
 
     BOOL IsIntersected = ChunksManager->GetSelectedBlock(Pos, Direction, PlayerChunkPos, MaxBlockSetDistance,
@@ -180,28 +180,43 @@ VOID player::SetBlock( VOID )
 
       if (BlockPos.x == -1)
       {
-        IntersectionChunkPos.first--;
+        IntersectionChunkPos.X--;
         BlockPos.x = chunk::ChunkSizeX - 1;
       }
 
       if (BlockPos.x == chunk::ChunkSizeX)
       {
-        IntersectionChunkPos.first++;
+        IntersectionChunkPos.X++;
         BlockPos.x = 0;
       }
 
-      if (BlockPos.y == -1 || BlockPos.y == chunk::ChunkSizeY)
-        return;
+      if (BlockPos.y == -1)
+      {
+        if (!ENABLE_CUBIC_CHUNKS)
+          return;
+
+        IntersectionChunkPos.Y--;
+        BlockPos.y = chunk::ChunkSizeY - 1;
+      }
+
+      if (BlockPos.y == chunk::ChunkSizeY)
+      {
+        if (!ENABLE_CUBIC_CHUNKS)
+          return;
+
+        IntersectionChunkPos.Y++;
+        BlockPos.y = 0;
+      }
 
       if (BlockPos.z == -1)
       {
-        IntersectionChunkPos.second--;
+        IntersectionChunkPos.Z--;
         BlockPos.z = chunk::ChunkSizeZ - 1;
       }
 
       if (BlockPos.z == chunk::ChunkSizeZ)
       {
-        IntersectionChunkPos.second++;
+        IntersectionChunkPos.Z++;
         BlockPos.z = 0;
       }
 
@@ -212,10 +227,12 @@ VOID player::SetBlock( VOID )
 
       if (ChunksManager->GetChunk(IntersectionChunkPos, IntersectionChunkPtr))
       {
-        if (IntersectionChunkPtr->Blocks[BlockInd].BlockTypeId == BLOCK_TYPE::AirId)
+        if (IntersectionChunkPtr->GetBlocks().Get(BlockInd).BlockTypeId == BLOCK_TYPE::AirId)
         {
-          IntersectionChunkPtr->Blocks[BlockInd].BlockTypeId = CurBlockId;
-          ChunksManager->UpdateBlock(IntersectionChunkPos, BlockPos);
+          BLOCK NewBlock = IntersectionChunkPtr->GetBlocks().Get(BlockInd);
+
+          NewBlock.BlockTypeId = CurBlockId;
+          ChunksManager->SetBlock(IntersectionChunkPos, BlockPos, NewBlock);
         }
       }
     }
@@ -229,7 +246,7 @@ VOID player::RemoveBlock( VOID )
 {
   if (ChunksManager != nullptr)
   {
-    std::pair<INT32, INT32> PlayerChunkPos = GetCurrentChunk();
+    CHUNK_POS PlayerChunkPos = GetCurrentChunk();
     glm::vec3 Pos;
 
     {
@@ -240,7 +257,7 @@ VOID player::RemoveBlock( VOID )
 
     glm::ivec3 BlockPos(0, 0, 0);
     FLT Near = INFINITY;
-    std::pair<INT32, INT32> IntersectionChunkPos;
+    CHUNK_POS IntersectionChunkPos;
     glm::ivec3 Normal(0, 0, 0);
 
     BOOL IsIntersected = ChunksManager->GetSelectedBlock(Pos, Direction, PlayerChunkPos, MaxBlockSetDistance,
@@ -255,8 +272,10 @@ VOID player::RemoveBlock( VOID )
 
       if (ChunksManager->GetChunk(IntersectionChunkPos, IntersectionChunkPtr))
       {
-        IntersectionChunkPtr->Blocks[BlockInd].BlockTypeId = BLOCK_TYPE::AirId;
-        ChunksManager->UpdateBlock(IntersectionChunkPos, BlockPos);
+        BLOCK NewBlock = IntersectionChunkPtr->GetBlocks().Get(BlockInd);
+
+        NewBlock.BlockTypeId = BLOCK_TYPE::AirId;
+        ChunksManager->SetBlock(IntersectionChunkPos, BlockPos, NewBlock);
       }
     }
   }
@@ -266,13 +285,14 @@ VOID player::RemoveBlock( VOID )
  * \brief Get currrent player chunk
  * \return Chunk position
  */
-std::pair<INT32, INT32> player::GetCurrentChunk( VOID )
+CHUNK_POS player::GetCurrentChunk( VOID )
 {
   std::lock_guard<std::mutex> Lock(PositionMutex);
 
   return
     {
       static_cast<INT32>(std::floor(Position.x / chunk::ChunkSizeX)),
+      ENABLE_CUBIC_CHUNKS ? static_cast<INT32>(std::floor(Position.y / chunk::ChunkSizeY)) : 0,
       static_cast<INT32>(std::floor(Position.z / chunk::ChunkSizeZ))
     };
 }
@@ -29,7 +29,7 @@ public:
    * \brief Get currrent player chunk
    * \return Chunk position
    */
-  std::pair<INT32, INT32> GetCurrentChunk( VOID );
+  CHUNK_POS GetCurrentChunk( VOID );
 
   /**
    * \brief Set chunks manager function
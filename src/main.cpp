@@ -36,22 +36,31 @@ INT main( INT ArgC, CHAR **ArgV )
     VkApp.InitApplication(0, Surface.GetSurfaceId());
 
     INT RenderDistance = 5;
-    INT MaxNumberOfChunks = (RenderDistance * 2 + 1) * (RenderDistance * 2 + 1);
+    INT VerticalRenderDistance = ENABLE_CUBIC_CHUNKS ? 2 : 0;
+    INT MaxNumberOfChunks = (RenderDistance * 2 + 1) * (RenderDistance * 2 + 1) * (VerticalRenderDistance * 2 + 1);
 
     render_synchronization Synchronization;
 
-    memory_manager MemoryManager(VkApp, MaxNumberOfChunks,
-      chunk_geometry::VertexBufferSize,
+    /* One more chunk geometry for re-meshed chunk which exists until swap with old geometry */
+    INT MaxNumberOfGeometries = MaxNumberOfChunks + 1;
+
+    /* Chunk meshes take exact ranges of one vertex buffer */
+    memory_manager MemoryManager(VkApp,
+      MaxNumberOfGeometries * Settings.AverageChunkBorders * chunk_geometry::QuadSize,
+      chunk_geometry::QuadSize,
       chunk_geometry::IndexBufferSize,
-      chunk_geometry::VertexBufferSize,
+      chunk_geometry::MaxUploadSize,
       sizeof(uniform_buffer),
       Synchronization);
 
-    render Render(VkApp, Surface, MaxNumberOfChunks * 2, MemoryManager, Synchronization);
+    chunk_geometry::FillIndexBuffer(MemoryManager);
+
+    render Render(VkApp, Surface, MaxNumberOfGeometries * 2, MemoryManager, Synchronization);
 
     player Player(Render, Window);
 
-    chunks_manager ChunksManager(Render, RenderDistance, Player);
+    chunks_manager ChunksManager(Render, RenderDistance, VerticalRenderDistance, Settings.LodDistances, Player,
+                                 Settings.NumberOfMeshingThreads);
 
     Player.SetChunksManager(&ChunksManager);
 
@@ -74,6 +83,11 @@ INT main( INT ArgC, CHAR **ArgV )
     });
 
     EventLoop.Run();
+
+    range_allocator::STATS VertexStats = MemoryManager.GetVertexStats();
+
+    std::cout << "Vertex memory: " << VertexStats.AllocatedSize << " of " << VertexStats.Capacity << " bytes used, " <<
+      VertexStats.NumberOfFreeRanges << " free ranges, fragmentation " << VertexStats.GetFragmentation() << "\n";
   }
   catch ( const std::runtime_error &Err )
   {
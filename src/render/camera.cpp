@@ -34,7 +34,23 @@ VOID camera::SetWH( INT W, INT H )
  */
 VOID camera::SetLocAtUp( const glm::vec3 &Loc, const glm::vec3 &To, const glm::vec3 &Up1 )
 {
+  this->Loc = Loc;
   ViewMatrix = glm::lookAt(Loc, To, Up1);
   
   ViewProjMatrix = ProjMatrix * ViewMatrix;
 }
+
+/**
+ * \brief Get view and projection matrix for coordinates relative to origin function
+ * \param[in] Origin World position of coordinate system origin
+ * \return View projection matrix
+ */
+glm::mat4 camera::GetViewProjMatrix( const glm::ivec3 &Origin ) const
+{
+  glm::mat4 RelativeViewMatrix = ViewMatrix;
+
+  /* Rotation is kept, translation is rebuilt from camera position relative to origin (stays small) */
+  RelativeViewMatrix[3] = glm::vec4(-(glm::mat3(ViewMatrix) * (Loc - glm::vec3(Origin))), 1);
+
+  return ProjMatrix * RelativeViewMatrix;
+}
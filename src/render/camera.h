@@ -31,13 +31,23 @@ public:
    */
   VOID SetLocAtUp( const glm::vec3 &Loc, const glm::vec3 &To, const glm::vec3 &Up1 );
 
+  /**
+   * \brief Get view and projection matrix for coordinates relative to origin function
+   * \param[in] Origin World position of coordinate system origin
+   * \return View projection matrix
+   */
+  glm::mat4 GetViewProjMatrix( const glm::ivec3 &Origin ) const;
+
+  /** Camera position */
+  glm::vec3 Loc = glm::vec3(0, 80, 0);
+
   /** Projection matrix */
   glm::mat4 ProjMatrix =
     glm::perspective(glm::pi<float>() * 0.25f, 1920.f / 1080, 0.1f, 1000.f);
 
   /** View matrix */
   glm::mat4 ViewMatrix =
-    glm::lookAt(glm::vec3(0, 80, 0), glm::vec3(20, 70, 20), glm::vec3(0, -1, 0));
+    glm::lookAt(Loc, glm::vec3(20, 70, 20), glm::vec3(0, -1, 0));
 
   /** View matrix and projection matrix multiplication */
   glm::mat4 ViewProjMatrix =
@@ -1,12 +1,22 @@
 #ifndef __chunk_geometry_h_
 #define __chunk_geometry_h_
 
+#include <array>
+
 #include "render.h"
 #include "draw_element.h"
-#include "game_objects/block.h"
+#include "vertex.h"
+#include "chunk_mesher.h"
+#include "game_objects/chunk_blocks.h"
+#include "game_objects/chunk_pos.h"
 
 /**
  * \brief Chunk display class
+ *
+ * Geometry is immutable: re-meshed chunk gets new geometry which replaces old one between frames.
+ * Opaque faces are grouped by direction, directions which can't face camera aren't drawn.
+ * Vertices are stored relative to chunk origin, chunk origin is pushed relative to render origin.
+ * Every geometry takes range of its size from vertex buffer shared by all chunks.
  */
 class chunk_geometry final : public draw_element
 {
@@ -15,33 +25,46 @@ public:
   static constexpr UINT ChunkSizeX = 16;
 
   /** Chunk size for Y-coordinate */
-  static constexpr UINT ChunkSizeY = 256;
+  static constexpr UINT ChunkSizeY = chunk_blocks::ChunkSizeY;
 
   /** Chunk size for Z-coordinate */
   static constexpr UINT ChunkSizeZ = 16;
 
-  /** Maximal number of borders */
-  const static UINT64 MaxNumberOfBorders;
-
-  /** Maximal number of indices */
-  const static UINT64 MaxNumberOfIndices;
+  /** Size of one border in vertex buffer (vertex buffer allocation unit) */
+  const static UINT64 QuadSize;
 
-  /** Maximal number of vertices */
-  const static UINT64 MaxNumberOfVertices;
+  /** Maximal size of one vertex upload (larger meshes are uploaded by parts) */
+  const static UINT64 MaxUploadSize;
 
-  /** Size of vertex buffer for chunk */
-  const static UINT64 VertexBufferSize;
+  /** Maximal number of borders drawn by one call */
+  const static UINT64 MaxNumberOfDrawBorders;
 
-  /** Size of index buffer for chunk */
+  /** Size of shared quad index buffer */
   const static UINT64 IndexBufferSize;
 
+  /**
+   * \brief Fill shared quad index buffer function
+   * \param[in] MemoryManager Memory manager
+   */
+  static VOID FillIndexBuffer( memory_manager &MemoryManager );
+
+  /**
+   * \brief Get size of vertex buffer range for mesh function
+   * \param[in] Mesh Chunk mesh
+   * \return Range size in bytes
+   */
+  static UINT64 GetVertexRangeSize( const CHUNK_MESH &Mesh );
+
   /**
    * \brief Chunk display class constructor
    * \param[in, out] Render Reference to render
-   * \param[in] Blocks Blocks array
+   * \param[in] Mesh Chunk mesh
    * \param[in] ChunkPos Chunk position
+   * \param[in] VertexRangeId Vertex buffer range of GetVertexRangeSize(Mesh) size (freed by geometry)
+   * \param[in] VertexBufferOffset Range offset in vertex buffer
    */
-  chunk_geometry( render &Render, const BLOCK *Blocks, const std::pair<INT32, INT32> &ChunkPos );
+  chunk_geometry( render &Render, const CHUNK_MESH &Mesh, const CHUNK_POS &ChunkPos, UINT32 VertexRangeId,
+                  UINT64 VertexBufferOffset );
 
   /**
    * \brief Get command buffer for draw function
@@ -55,181 +78,82 @@ public:
    */
   VkCommandBuffer GetTransparentCommandBuffer( VOID ) override;
 
-  ///**
-  // * \brief Update WVP function
-  // */
-  //VOID UpdateWVP( VOID ) override;
-
-  /**
-   * \brief Chunk geometry destructor
-   */
-  ~chunk_geometry( VOID );
-
   /**
-   * \brief Update block function
-   * \param[in] BlockPos Block position
-   * \param[in] Blocks Blocks array
+   * \brief Update camera position function (called with render mutex locked)
+   * \param[in] CameraPos Camera position
+   * \return TRUE if set of drawn face directions was changed
    */
-  VOID UpdateBlock( const glm::ivec3 &BlockPos, const BLOCK *Blocks );
+  BOOL SetCameraPosition( const glm::vec3 &CameraPos ) override;
 
   /**
-   * \brief Update up block border
-   * \param[in] BlockPos Block position
-   * \param[in] Blocks Blocks array
+   * \brief Update render origin function (called with render mutex locked)
+   * \param[in] Origin World position of render origin
+   * \return TRUE if chunk origin relative to render origin was changed
    */
-  VOID UpdateUpSide( const glm::ivec3 &BlockPos, const BLOCK *Blocks );
+  BOOL SetRenderOrigin( const glm::ivec3 &Origin ) override;
 
-  /**
-   * \brief Update left block border
-   * \param[in] BlockPos Block position
-   * \param[in] Blocks Blocks array
-   */
-  VOID UpdateLeftSide( const glm::ivec3 &BlockPos, const BLOCK *Blocks );
-
-  /**
-   * \brief Update down block border
-   * \param[in] BlockPos Block position
-   * \param[in] Blocks Blocks array
-   */
-  VOID UpdateDownSide( const glm::ivec3 &BlockPos, const BLOCK *Blocks );
-
-  /**
-   * \brief Update right block border
-   * \param[in] BlockPos Block position
-   * \param[in] Blocks Blocks array
-   */
-  VOID UpdateRightSide( const glm::ivec3 &BlockPos, const BLOCK *Blocks );
-
-  /**
-   * \brief Update front block border
-   * \param[in] BlockPos Block position
-   * \param[in] Blocks Blocks array
-   */
-  VOID UpdateFrontSide( const glm::ivec3 &BlockPos, const BLOCK *Blocks );
-
-  /**
-   * \brief Update back block border
-   * \param[in] BlockPos Block position
-   * \param[in] Blocks Blocks array
-   */
-  VOID UpdateBackSide( const glm::ivec3 &BlockPos, const BLOCK *Blocks );
+  ///**
+  // * \brief Update WVP function
+  // */
+  //VOID UpdateWVP( VOID ) override;
 
   /**
-   * \brief Update command buffer function
+   * \brief Chunk geometry destructor
    */
-  VOID UpdateCommandBuffer( VOID ) const;
+  ~chunk_geometry( VOID );
 
 private:
   /**
-   * \brief Remove up border function
-   * \param[in] BlockPos Block position
+   * \brief Get face directions which can face camera function
+   * \param[in] CameraPos Camera position
+   * \return Faces mask (bit i is set for face direction i)
    */
-  VOID RemoveUpBorder( const glm::ivec3 &BlockPos );
+  UINT32 GetVisibleFaces( const glm::vec3 &CameraPos ) const;
 
   /**
-   * \brief Remove down border function
-   * \param[in] BlockPos Block position
+   * \brief Write mesh to vertex buffer layout function
+   * \param[in] Mesh Chunk mesh
+   * \param[out] Data Memory for borders (opaque borders grouped by face direction, then transparent borders)
    */
-  VOID RemoveDownBorder( const glm::ivec3 &BlockPos );
+  VOID WriteMesh( const CHUNK_MESH &Mesh, BYTE *Data ) const;
 
   /**
-   * \brief Remove right border function
-   * \param[in] BlockPos Block position
+   * \brief Fill command buffer for opaque faces function
    */
-  VOID RemoveRightBorder( const glm::ivec3 &BlockPos );
-
-  /**
-   * \brief Remove left border function
-   * \param[in] BlockPos Block position
-   */
-  VOID RemoveLeftBorder( const glm::ivec3 &BlockPos );
-
-  /**
-   * \brief Remove front border function
-   * \param[in] BlockPos Block position
-   */
-  VOID RemoveFrontBorder( const glm::ivec3 &BlockPos );
-
-  /**
-   * \brief Remove back border function
-   * \param[in] BlockPos Block position
-   * \param[in] TexCoords Texture coordinates
-   * \param[in] Alpha Alpha part
-   */
-  VOID RemoveBackBorder( const glm::ivec3 &BlockPos );
-
-  /**
-   * \brief Add up border function
-   * \param[in] BlockPos Block position
-   * \param[in] TexCoords Texture coordinates
-   * \param[in] Alpha Alpha part
-   */
-  VOID AddUpBorder( const glm::ivec3 &BlockPos, const glm::vec2 *TexCoords, FLT Alpha );
-
-  /**
-   * \brief Add down border function
-   * \param[in] BlockPos Block position
-   * \param[in] TexCoords Texture coordinates
-   * \param[in] Alpha Alpha part
-   */
-  VOID AddDownBorder( const glm::ivec3 &BlockPos, const glm::vec2 *TexCoords, FLT Alpha );
-
-  /**
-   * \brief Add right border function
-   * \param[in] BlockPos Block position
-   * \param[in] TexCoords Texture coordinates
-   * \param[in] Alpha Alpha part
-   */
-  VOID AddRightBorder( const glm::ivec3 &BlockPos, const glm::vec2 *TexCoords, FLT Alpha );
-
-  /**
-   * \brief Add left border function
-   * \param[in] BlockPos Block position
-   * \param[in] TexCoords Texture coordinates
-   * \param[in] Alpha Alpha part
-   */
-  VOID AddLeftBorder( const glm::ivec3 &BlockPos, const glm::vec2 *TexCoords, FLT Alpha );
+  VOID CreateCommandBuffer( VOID ) const;
 
   /**
-   * \brief Add front border function
-   * \param[in] BlockPos Block position
-   * \param[in] TexCoords Texture coordinates
-   * \param[in] Alpha Alpha part
+   * \brief Fill command buffer for transparent faces function
    */
-  VOID AddFrontBorder( const glm::ivec3 &BlockPos, const glm::vec2 *TexCoords, FLT Alpha );
+  VOID CreateTransparentCommandBuffer( VOID ) const;
 
   /**
-   * \brief Add back border function
-   * \param[in] BlockPos Block position
-   * \param[in] TexCoords Texture coordinates
-   * \param[in] Alpha Alpha part
+   * \brief Begin secondary command buffer and bind chunk buffers function
+   * \param[in] CommandBufferId Command buffer
    */
-  VOID AddBackBorder( const glm::ivec3 &BlockPos, const glm::vec2 *TexCoords, FLT Alpha );
+  VOID BeginCommandBuffer( VkCommandBuffer CommandBufferId ) const;
 
   /**
-   * \brief Fill command buffer function
+   * \brief Draw range of borders function
+   * \param[in] CommandBufferId Command buffer
+   * \param[in] FirstBorder First border slot
+   * \param[in] Count Number of borders
    */
-  VOID CreateCommandBuffer( VOID ) const;
+  VOID DrawBorders( VkCommandBuffer CommandBufferId, UINT64 FirstBorder, UINT64 Count ) const;
 
-  /** Memory chunk index */
-  UINT32 MemoryChunkId;
+  /** Vertex buffer range index */
+  UINT32 VertexRangeId;
 
   /** Offset in vertex buffer */
   UINT64 VertexBufferOffset;
 
-  /** Offset in index buffer */
-  UINT64 IndexBufferOffset;
-
   /** Reference to vertex buffer memory */
   const memory &VertexMemory;
 
-  /** Reference to index buffer memory */
-  const memory &IndexMemory;
-
   /** Reference to vertex buffer */
   const buffer &VertexBuffer;
 
-  /** Reference to index buffer */
+  /** Reference to shared quad index buffer */
   const buffer &IndexBuffer;
 
   /** Command buffer */
@@ -259,62 +183,20 @@ private:
   /** Number of borders */
   UINT64 NumberOfTransparentBorders;
 
-  /** mutex for blocks and indices information */
-  std::mutex MetaInfoMutex;
-
-  /**
-   * \brief Block geometry information
-   */
-  struct BLOCK_INFORMATION
-  {
-    /** +Y block border index */
-    INT64 UpOffset = -1;
-
-    /** -Y block border index */
-    INT64 DownOffset = -1;
-
-    /** +X block border index */
-    INT64 RightOffset = -1;
-
-    /** -X block border index */
-    INT64 LeftOffset = -1;
-
-    /** +Z block border index */
-    INT64 FrontOffset = -1;
-
-    /** -Z block border index */
-    INT64 BackOffset = -1;
-  };
-
-  /**
-   * \brief Border index information
-   */
-  struct INDEX_INFORMATION
-  {
-    /** Block identifier */
-    INT64 BlockId = -1;
-
-    /** Pointer to border index in block information */
-    INT64 BLOCK_INFORMATION::*Offset = nullptr;
-  };
-
-  /** Blocks information */
-  BLOCK_INFORMATION BlocksInfo[ChunkSizeZ * ChunkSizeY * ChunkSizeX];
-
-  /** Indices to blocks table */
-  std::vector<INDEX_INFORMATION> IndicesInfo;
+  /** Chunk position */
+  CHUNK_POS Position;
 
-  /** Indices to blocks table */
-  std::vector<INDEX_INFORMATION> TransparentIndicesInfo;
+  /** First opaque border of every face direction (last element - number of opaque borders) */
+  std::array<UINT64, BLOCK::NumberOfFaces + 1> FaceOffsets;
 
-  /** Chunk offset x */
-  DBL ChunkOffsetX;
+  /** Minimal and maximal face plane coordinates along normal for every face direction */
+  std::array<glm::vec2, BLOCK::NumberOfFaces> FacePlanes;
 
-  /** Chunk offset z */
-  DBL ChunkOffsetZ;
+  /** Face directions drawn in opaque command buffer */
+  UINT32 VisibleFaces;
 
-  /** Chunk blocks */
-  const BLOCK *ChunkBlocks = nullptr;
+  /** Render origin applied to command buffers */
+  glm::ivec3 RenderOrigin;
 };
 
 #endif /* __chunk_geometry_h_ */
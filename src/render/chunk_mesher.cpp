@@ -0,0 +1,759 @@
+#include <algorithm>
+#include <cfloat>
+#include <cstring>
+#include <limits>
+
+#include "chunk_mesher.h"
+#include "greedy_mesher.h"
+#include "game_objects/block_type.h"
+
+/** Number of bitset words in one Z-layer of chunk */
+static constexpr UINT32 WordsPerLayer = chunk_blocks::ChunkSizeY * chunk_blocks::ChunkSizeX / 64;
+
+/** Bits of blocks with x = 0 in bitset word */
+static constexpr UINT64 FirstColumnBits = 0x0001000100010001ull;
+
+/** Bits of blocks with x = ChunkSizeX - 1 in bitset word */
+static constexpr UINT64 LastColumnBits = FirstColumnBits << (chunk_blocks::ChunkSizeX - 1);
+
+static_assert(chunk_blocks::ChunkSizeX == 16 && chunk_blocks::ChunkSizeY % 4 == 0,
+              "visibility kernel expects 4 rows of 16 blocks in every bitset word");
+
+/**
+ * \brief Spread 4 bits to first bits of 16-bit rows function
+ * \param[in] Bits Bits for rows
+ * \return Word with bit k moved to bit 16 * k
+ */
+static UINT64 SpreadToRows( UINT64 Bits )
+{
+  return (Bits & 1) | ((Bits & 2) << 15) | ((Bits & 4) << 30) | ((Bits & 8) << 45);
+}
+
+/**
+ * \brief Build face visibility mask of one face direction function (direction is known at compile time)
+ * \param[in] Blocks Blocks storage
+ * \param[in] Borders Neighbour borders
+ * \param[out] Visible Face visibility mask
+ * \param[in] MinWord First bitset word of rows in Z-layer
+ * \param[in] MaxWord Last bitset word of rows in Z-layer
+ */
+template<UINT32 Face>
+static VOID GetFaceVisibilityMask( const chunk_blocks &Blocks, const CHUNK_BORDERS &Borders,
+                                   chunk_mesher::VISIBILITY_MASK &Visible, UINT32 MinWord, UINT32 MaxWord )
+{
+  const UINT64 *Opaque = Blocks.GetOpaqueBits().data();
+  const UINT64 *NotAir = Blocks.GetNotAirBits().data();
+
+  for (UINT32 z = 0; z < chunk_blocks::ChunkSizeZ; z++)
+    for (UINT32 w = MinWord; w <= MaxWord; w++)
+    {
+      UINT32 i = z * WordsPerLayer + w;
+      UINT32 y = w * 4;
+      UINT64 Neighbours;
+
+      if constexpr (Face == BLOCK::FaceLeft)
+        Neighbours = ((Opaque[i] << 1) & ~FirstColumnBits) |
+                     SpreadToRows(Borders.GetBits(Face, z * chunk_blocks::ChunkSizeY + y, 4));
+      else if constexpr (Face == BLOCK::FaceRight)
+        Neighbours = ((Opaque[i] >> 1) & ~LastColumnBits) |
+                     (SpreadToRows(Borders.GetBits(Face, z * chunk_blocks::ChunkSizeY + y, 4)) << 15);
+      else if constexpr (Face == BLOCK::FaceDown)
+        Neighbours = (Opaque[i] << 16) | (w > 0 ? Opaque[i - 1] >> 48 :
+                                          Borders.GetBits(Face, z * chunk_blocks::ChunkSizeX, 16));
+      else if constexpr (Face == BLOCK::FaceUp)
+        Neighbours = (Opaque[i] >> 16) | ((w + 1 < WordsPerLayer ? Opaque[i + 1] :
+                                           Borders.GetBits(Face, z * chunk_blocks::ChunkSizeX, 16)) << 48);
+      else if constexpr (Face == BLOCK::FaceBack)
+        Neighbours = z > 0 ? Opaque[i - WordsPerLayer] : Borders.GetBits(Face, w * 64, 64);
+      else
+        Neighbours = z + 1 < chunk_blocks::ChunkSizeZ ? Opaque[i + WordsPerLayer] : Borders.GetBits(Face, w * 64, 64);
+
+      Visible[i] = NotAir[i] & ~Neighbours;
+    }
+}
+
+/**
+ * \brief Add one quad for every visible face of one face direction function (direction is known at compile time)
+ * \param[in] Blocks Blocks storage
+ * \param[in] Visible Face visibility mask
+ * \param[in] MinWord First bitset word of rows in Z-layer
+ * \param[in] MaxWord Last bitset word of rows in Z-layer
+ * \param[in, out] Quads Quads array (quads are appended)
+ */
+template<UINT32 Face>
+static VOID AddFaceQuads( const chunk_blocks &Blocks, const chunk_mesher::VISIBILITY_MASK &Visible,
+                          UINT32 MinWord, UINT32 MaxWord, std::vector<chunk_mesher::QUAD> &Quads )
+{
+  chunk_mesher::QUAD Quad;
+
+  Quad.Face = Face;
+  Quad.SizeA = 1;
+  Quad.SizeB = 1;
+
+  for (UINT32 z = 0; z < chunk_blocks::ChunkSizeZ; z++)
+    for (UINT32 w = MinWord; w <= MaxWord; w++)
+    {
+      UINT32 i = z * WordsPerLayer + w;
+
+      /* Iterate only set bits of word */
+      for (UINT64 Bits = Visible[i]; Bits != 0; Bits &= Bits - 1)
+      {
+        UINT32 Index = i * 64 + chunk_mesher::GetLowestBit(Bits);
+        const BLOCK &Block = Blocks.Get(Index);
+
+        Quad.Origin = glm::ivec3(Index % chunk_blocks::ChunkSizeX, Index / chunk_blocks::ChunkSizeX % chunk_blocks::ChunkSizeY,
+                                 Index / (chunk_blocks::ChunkSizeX * chunk_blocks::ChunkSizeY));
+        Quad.Texture = BLOCK_TYPE::GetFaceTexture(Block, Face);
+        Quad.Alpha = BLOCK_TYPE::Table[Block.BlockTypeId].Alpha;
+
+        Quads.push_back(Quad);
+      }
+    }
+}
+
+/**
+ * \brief Build quad vertices of one face direction function (direction is known at compile time)
+ * \param[in] Quad Quad description
+ * \param[out] Vertices 4 vertices
+ */
+template<UINT32 Face>
+static VOID GetFaceQuadVertices( const chunk_mesher::QUAD &Quad, VERTEX *Vertices )
+{
+  constexpr chunk_mesher::FACE_AXES Axes = chunk_mesher::FaceAxes[Face];
+
+  /* Corner offsets along first and second face axes (in quad sizes) */
+  constexpr INT32 CornersA[4] = {0, 1, 1, 0};
+  constexpr INT32 CornersB[4] = {0, 0, 1, 1};
+
+  glm::ivec3 Origin = Quad.Origin;
+
+  Origin[Axes.N] += Face & 1;
+
+  /* Tile coordinates are scaled by quad size, shader repeats texture tile */
+  const glm::vec2 *TexCoords = BLOCK_TYPE::TexCoords[Quad.Texture].data();
+  glm::vec2 TexScale(Quad.SizeB, Quad.SizeA);
+
+  for (UINT32 i = 0; i < 4; i++)
+  {
+    glm::ivec3 Corner = Origin;
+
+    Corner[Axes.A] += CornersA[i] * Quad.SizeA;
+    Corner[Axes.B] += CornersB[i] * Quad.SizeB;
+
+    Vertices[i].Position = VERTEX::PackPosition(Corner);
+    Vertices[i].Alpha = Quad.Alpha;
+    Vertices[i].TexCoord = TexCoords[i] * TexScale;
+    Vertices[i].Texture = Quad.Texture;
+  }
+}
+
+/** Visibility mask kernels for every face direction */
+static VOID (* const FaceVisibilityMaskKernels[BLOCK::NumberOfFaces])( const chunk_blocks &, const CHUNK_BORDERS &,
+                                                                       chunk_mesher::VISIBILITY_MASK &, UINT32, UINT32 ) =
+{
+  GetFaceVisibilityMask<BLOCK::FaceLeft>, GetFaceVisibilityMask<BLOCK::FaceRight>,
+  GetFaceVisibilityMask<BLOCK::FaceDown>, GetFaceVisibilityMask<BLOCK::FaceUp>,
+  GetFaceVisibilityMask<BLOCK::FaceBack>, GetFaceVisibilityMask<BLOCK::FaceFront>,
+};
+
+/** Per-face quads kernels for every face direction */
+static VOID (* const FaceQuadsKernels[BLOCK::NumberOfFaces])( const chunk_blocks &, const chunk_mesher::VISIBILITY_MASK &,
+                                                              UINT32, UINT32, std::vector<chunk_mesher::QUAD> & ) =
+{
+  AddFaceQuads<BLOCK::FaceLeft>, AddFaceQuads<BLOCK::FaceRight>,
+  AddFaceQuads<BLOCK::FaceDown>, AddFaceQuads<BLOCK::FaceUp>,
+  AddFaceQuads<BLOCK::FaceBack>, AddFaceQuads<BLOCK::FaceFront>,
+};
+
+/** Quad vertices kernels for every face direction */
+static VOID (* const FaceVerticesKernels[BLOCK::NumberOfFaces])( const chunk_mesher::QUAD &, VERTEX * ) =
+{
+  GetFaceQuadVertices<BLOCK::FaceLeft>, GetFaceQuadVertices<BLOCK::FaceRight>,
+  GetFaceQuadVertices<BLOCK::FaceDown>, GetFaceQuadVertices<BLOCK::FaceUp>,
+  GetFaceQuadVertices<BLOCK::FaceBack>, GetFaceQuadVertices<BLOCK::FaceFront>,
+};
+
+/**
+ * \brief Get world position of chunk origin function
+ * \param[in] ChunkPos Chunk position
+ * \return Chunk origin
+ */
+static glm::vec3 GetChunkOrigin( const CHUNK_POS &ChunkPos )
+{
+  return glm::vec3(chunk_blocks::ChunkSizeX * (DBL)ChunkPos.X, chunk_blocks::ChunkSizeY * (DBL)ChunkPos.Y,
+                   chunk_blocks::ChunkSizeZ * (DBL)ChunkPos.Z);
+}
+
+/**
+ * \brief Get number of opaque quads function
+ * \return Number of quads in all face directions
+ */
+UINT64 CHUNK_MESH::GetNumberOfQuads( VOID ) const
+{
+  UINT64 NumberOfQuads = 0;
+
+  for (UINT32 Face = 0; Face < BLOCK::NumberOfFaces; Face++)
+    NumberOfQuads += GetNumberOfQuads(Face);
+
+  return NumberOfQuads;
+}
+
+/**
+ * \brief Clear mesh function
+ */
+VOID CHUNK_MESH::Clear( VOID )
+{
+  for (UINT32 Face = 0; Face < BLOCK::NumberOfFaces; Face++)
+  {
+    Vertices[Face].clear();
+    Faces[Face].clear();
+    FacePlanes[Face] = glm::vec2(std::numeric_limits<FLT>::max(), std::numeric_limits<FLT>::lowest());
+  }
+
+  TransparentFaces.clear();
+  TransparentVertices.clear();
+}
+
+/**
+ * \brief Get content hash of borders function
+ * \return Hash of opacity bits (empty and loaded borders differ)
+ */
+UINT64 CHUNK_BORDERS::GetHash( VOID ) const
+{
+  UINT64 Hash = chunk_mesher::HashBasis;
+
+  for (const std::vector<UINT64> &Border : Opaque)
+  {
+    UINT64 Size = Border.size();
+
+    Hash = chunk_mesher::GetHash(&Size, sizeof(UINT64), Hash);
+    Hash = chunk_mesher::GetHash(Border.data(), Border.size() * sizeof(UINT64), Hash);
+  }
+
+  return Hash;
+}
+
+/**
+ * \brief Get face axes function
+ * \param[in] Face Face index (BLOCK::Face* constant)
+ * \return Face axes
+ */
+const chunk_mesher::FACE_AXES & chunk_mesher::GetFaceAxes( UINT32 Face )
+{
+  return FaceAxes[Face];
+}
+
+/**
+ * \brief Get chunk size along axis function
+ * \param[in] Axis Axis index (0 - x, 1 - y, 2 - z)
+ * \return Chunk size
+ */
+INT32 chunk_mesher::GetChunkSize( UINT32 Axis )
+{
+  return ChunkSizes[Axis];
+}
+
+/**
+ * \brief Get border cell of block function
+ * \param[in] Pos Block position in chunk
+ * \param[in] Face Face direction (BLOCK::Face* constant)
+ * \return Cell index in border
+ */
+UINT32 chunk_mesher::GetBorderCell( const glm::ivec3 &Pos, UINT32 Face )
+{
+  /* Border keeps block index order without normal coordinate */
+  UINT32 N = FaceAxes[Face].N;
+  UINT32 Low = N == 0 ? 1 : 0, High = N == 2 ? 1 : 2;
+
+  return Pos[High] * ChunkSizes[Low] + Pos[Low];
+}
+
+/**
+ * \brief Get block of border cell function
+ * \param[in] Cell Cell index in border
+ * \param[in] Face Face direction (BLOCK::Face* constant)
+ * \return Position of chunk block adjacent to neighbour
+ */
+glm::ivec3 chunk_mesher::GetBorderPos( UINT32 Cell, UINT32 Face )
+{
+  UINT32 N = FaceAxes[Face].N;
+  UINT32 Low = N == 0 ? 1 : 0, High = N == 2 ? 1 : 2;
+  glm::ivec3 Pos;
+
+  Pos[N] = (Face & 1) ? ChunkSizes[N] - 1 : 0;
+  Pos[Low] = Cell % ChunkSizes[Low];
+  Pos[High] = Cell / ChunkSizes[Low];
+
+  return Pos;
+}
+
+/**
+ * \brief Build neighbour border function
+ * \param[in] Neighbour Neighbour chunk blocks
+ * \param[in] Face Direction from chunk to neighbour (BLOCK::Face* constant)
+ * \param[out] Border Opacity bits of neighbour layer adjacent to chunk
+ */
+VOID chunk_mesher::GetBorder( const chunk_blocks &Neighbour, UINT32 Face, std::vector<UINT64> &Border )
+{
+  const FACE_AXES &Axes = FaceAxes[Face];
+  UINT32 SizeA = ChunkSizes[Axes.A], SizeB = ChunkSizes[Axes.B];
+
+  Border.assign((SizeA * SizeB + 63) / 64, 0);
+
+  glm::ivec3 Pos(0);
+
+  /* Neighbour in positive direction touches chunk by its first layer */
+  Pos[Axes.N] = (Face & 1) ? 0 : ChunkSizes[Axes.N] - 1;
+
+  for (UINT32 b = 0; b < SizeB; b++)
+    for (UINT32 a = 0; a < SizeA; a++)
+    {
+      Pos[Axes.A] = a;
+      Pos[Axes.B] = b;
+
+      if (Neighbour.IsOpaque(GetIndex(Pos)))
+      {
+        UINT32 Cell = GetBorderCell(Pos, Face);
+
+        Border[Cell / 64] |= 1ull << (Cell % 64);
+      }
+    }
+}
+
+/**
+ * \brief Check face visibility function
+ * \param[in] Blocks Blocks storage
+ * \param[in] Borders Neighbour borders
+ * \param[in] Pos Block position in chunk
+ * \param[in] Face Face index (BLOCK::Face* constant)
+ * \return TRUE if block isn't air and face isn't covered by opaque block
+ */
+BOOL chunk_mesher::IsFaceVisible( const chunk_blocks &Blocks, const CHUNK_BORDERS &Borders,
+                                  const glm::ivec3 &Pos, UINT32 Face )
+{
+  if (Blocks.IsAir(GetIndex(Pos)))
+    return FALSE;
+
+  UINT32 N = FaceAxes[Face].N;
+  glm::ivec3 NeighbourPos = Pos + BLOCK::FaceNormals[Face];
+
+  if (NeighbourPos[N] < 0 || NeighbourPos[N] >= ChunkSizes[N])
+    return !Borders.IsOpaque(Face, GetBorderCell(Pos, Face));
+
+  return !Blocks.IsOpaque(GetIndex(NeighbourPos));
+}
+
+/**
+ * \brief Build face visibility mask for chunk rows function
+ *
+ * Every bitset word contains 4 rows along X-coordinate, so neighbours along X and Y are
+ * found by shifts of word, neighbours along Z are in other word with same bit position.
+ * \param[in] Blocks Blocks storage
+ * \param[in] Borders Neighbour borders
+ * \param[in] Face Face index (BLOCK::Face* constant)
+ * \param[out] Visible Face visibility mask (only words of occupied rows are filled)
+ * \param[in] MinY Minimal Y-coordinate of rows (multiple of 4)
+ * \param[in] MaxY Maximal Y-coordinate of rows
+ */
+VOID chunk_mesher::GetVisibilityMask( const chunk_blocks &Blocks, const CHUNK_BORDERS &Borders, UINT32 Face,
+                                      VISIBILITY_MASK &Visible, INT32 MinY, INT32 MaxY )
+{
+  MinY = std::max(MinY, Blocks.GetMinY());
+  MaxY = std::min(MaxY, Blocks.GetMaxY());
+
+  if (MinY > MaxY)
+    return;
+
+  FaceVisibilityMaskKernels[Face](Blocks, Borders, Visible, MinY / 4, MaxY / 4);
+}
+
+/**
+ * \brief Build quad vertices function
+ * \param[in] Quad Quad description
+ * \param[out] Vertices 4 vertices (positions in chunk)
+ */
+VOID chunk_mesher::GetQuadVertices( const QUAD &Quad, VERTEX *Vertices )
+{
+  FaceVerticesKernels[Quad.Face](Quad, Vertices);
+}
+
+/**
+ * \brief Pack quad to 32-bit face record function
+ *
+ * Bits: 0-3 - x, 4-11 - y, 12-15 - z (origin in chunk), 16-18 - face, 19-22 - size along first axis - 1,
+ * 23-26 - size along second axis - 1, 27-31 - texture index. Alpha is taken from texture by shader.
+ * \param[in] Quad Quad description
+ * \return Packed face
+ */
+UINT32 chunk_mesher::PackQuad( const QUAD &Quad )
+{
+  static_assert(chunk_blocks::ChunkSizeX <= 16 && chunk_blocks::ChunkSizeY <= 256 && chunk_blocks::ChunkSizeZ <= 16);
+
+  return Quad.Origin.x | (Quad.Origin.y << 4) | (Quad.Origin.z << 12) | (Quad.Face << 16) |
+         ((Quad.SizeA - 1) << 19) | ((Quad.SizeB - 1) << 23) | (Quad.Texture << (32 - PackedTextureBits));
+}
+
+/**
+ * \brief Add quad to mesh function
+ * \param[in, out] Mesh Chunk mesh
+ * \param[in] Quad Quad description
+ * \param[in] ChunkPos Chunk position
+ */
+VOID chunk_mesher::AddQuad( CHUNK_MESH &Mesh, const QUAD &Quad, const CHUNK_POS &ChunkPos )
+{
+  BOOL IsTransparent = Quad.Alpha < 1 - FLT_EPSILON;
+
+  if (!IsTransparent)
+  {
+    UINT32 N = FaceAxes[Quad.Face].N;
+    FLT Plane = GetChunkOrigin(ChunkPos)[N] + Quad.Origin[N] + (Quad.Face & 1);
+    glm::vec2 &FacePlane = Mesh.FacePlanes[Quad.Face];
+
+    FacePlane = glm::vec2(std::min(FacePlane.x, Plane), std::max(FacePlane.y, Plane));
+  }
+
+#if ENABLE_VERTEX_PULLING
+  (IsTransparent ? Mesh.TransparentFaces : Mesh.Faces[Quad.Face]).push_back(PackQuad(Quad));
+#else /* ENABLE_VERTEX_PULLING */
+  std::vector<VERTEX> &Vertices = IsTransparent ? Mesh.TransparentVertices : Mesh.Vertices[Quad.Face];
+  UINT64 Base = Vertices.size();
+
+  Vertices.resize(Base + 4);
+  GetQuadVertices(Quad, Vertices.data() + Base);
+#endif /* ENABLE_VERTEX_PULLING */
+}
+
+/**
+ * \brief Add quads to mesh function
+ * \param[in, out] Mesh Chunk mesh
+ * \param[in] Quads Quads array
+ * \param[in] ChunkPos Chunk position
+ */
+VOID chunk_mesher::AddQuads( CHUNK_MESH &Mesh, const std::vector<QUAD> &Quads, const CHUNK_POS &ChunkPos )
+{
+  /* Quads are counted first, so every bucket grows once per batch (last counter - transparent quads) */
+  std::array<UINT64, BLOCK::NumberOfFaces + 1> Counts = {};
+
+  for (const QUAD &Quad : Quads)
+    Counts[Quad.Alpha < 1 - FLT_EPSILON ? BLOCK::NumberOfFaces : Quad.Face]++;
+
+  for (UINT32 Face = 0; Face < BLOCK::NumberOfFaces; Face++)
+  {
+    Mesh.Vertices[Face].reserve(Mesh.Vertices[Face].size() + (ENABLE_VERTEX_PULLING ? 0 : Counts[Face] * 4));
+    Mesh.Faces[Face].reserve(Mesh.Faces[Face].size() + (ENABLE_VERTEX_PULLING ? Counts[Face] : 0));
+  }
+
+  Mesh.TransparentVertices.reserve(Mesh.TransparentVertices.size() +
+                                   (ENABLE_VERTEX_PULLING ? 0 : Counts[BLOCK::NumberOfFaces] * 4));
+  Mesh.TransparentFaces.reserve(Mesh.TransparentFaces.size() +
+                                (ENABLE_VERTEX_PULLING ? Counts[BLOCK::NumberOfFaces] : 0));
+
+  for (const QUAD &Quad : Quads)
+    AddQuad(Mesh, Quad, ChunkPos);
+}
+
+/**
+ * \brief Build quads of one chunk section function
+ * \param[in] Blocks Blocks storage
+ * \param[in] Borders Neighbour borders
+ * \param[in] SectionId Section index (from bottom)
+ * \param[in, out] Quads Quads array (quads are appended)
+ * \param[in] Greedy Greedy meshing flag (quads don't cross section)
+ */
+VOID chunk_mesher::BuildSectionQuads( const chunk_blocks &Blocks, const CHUNK_BORDERS &Borders, UINT32 SectionId,
+                                      std::vector<QUAD> &Quads, BOOL Greedy )
+{
+  if (Blocks.IsSectionEmpty(SectionId))
+    return;
+
+  INT32 MinY = SectionId * chunk_blocks::SectionSize, MaxY = MinY + chunk_blocks::SectionSize - 1;
+  VISIBILITY_MASK Visible;
+
+  if (Greedy)
+  {
+    for (UINT32 Face = 0; Face < BLOCK::NumberOfFaces; Face++)
+    {
+      UINT32 N = FaceAxes[Face].N;
+
+      /* Visibility is computed once for all slices of face direction */
+      GetVisibilityMask(Blocks, Borders, Face, Visible, MinY, MaxY);
+
+      /* Only Y-layers of section are sliced along Y, other slices are bounded by section rows */
+      for (INT32 Layer = N == 1 ? MinY : 0, LastLayer = N == 1 ? MaxY : ChunkSizes[N] - 1; Layer <= LastLayer; Layer++)
+        greedy_mesher::MeshSlice(Blocks, Visible, Face, Layer, Quads, TRUE, MinY, MaxY);
+    }
+
+    return;
+  }
+
+  UINT32 MinWord = std::max(MinY, Blocks.GetMinY()) / 4, MaxWord = std::min(MaxY, Blocks.GetMaxY()) / 4;
+
+  for (UINT32 Face = 0; Face < BLOCK::NumberOfFaces; Face++)
+  {
+    FaceVisibilityMaskKernels[Face](Blocks, Borders, Visible, MinWord, MaxWord);
+    FaceQuadsKernels[Face](Blocks, Visible, MinWord, MaxWord, Quads);
+  }
+}
+
+/**
+ * \brief Build chunk mesh function
+ * \param[in] Blocks Blocks storage
+ * \param[in] Borders Neighbour borders
+ * \param[in] ChunkPos Chunk position
+ * \param[out] Mesh Chunk mesh
+ * \param[in] Greedy Greedy meshing flag
+ */
+VOID chunk_mesher::Build( const chunk_blocks &Blocks, const CHUNK_BORDERS &Borders, const CHUNK_POS &ChunkPos,
+                          CHUNK_MESH &Mesh, BOOL Greedy )
+{
+  std::vector<QUAD> Quads;
+
+  Mesh.Clear();
+
+  for (UINT32 SectionId = 0; SectionId < chunk_blocks::NumberOfSections; SectionId++)
+  {
+    Quads.clear();
+    BuildSectionQuads(Blocks, Borders, SectionId, Quads, Greedy);
+    AddQuads(Mesh, Quads, ChunkPos);
+  }
+}
+
+/**
+ * \brief Downsample blocks for level of detail function
+ *
+ * Every cell of 2^Lod blocks along each axis is filled with its highest opaque (or, without opaque blocks,
+ * highest not air) block if at least half of cell isn't air, and is left air otherwise.
+ * Greedy meshing merges faces of filled cells.
+ * \param[in] Blocks Blocks storage
+ * \param[in] Lod Level of detail (less than NumberOfLods)
+ * \param[out] Coarse Downsampled blocks (must be empty)
+ */
+VOID chunk_mesher::Downsample( const chunk_blocks &Blocks, UINT32 Lod, chunk_blocks &Coarse )
+{
+  const INT32 CellSize = 1 << Lod;
+
+  static_assert(chunk_blocks::ChunkSizeY % (1 << (NumberOfLods - 1)) == 0);
+
+  /* Cells above and below blocks are air */
+  for (INT32 CellZ = 0; CellZ < chunk_blocks::ChunkSizeZ; CellZ += CellSize)
+    for (INT32 CellY = Blocks.GetMinY() / CellSize * CellSize; CellY <= Blocks.GetMaxY(); CellY += CellSize)
+      for (INT32 CellX = 0; CellX < chunk_blocks::ChunkSizeX; CellX += CellSize)
+      {
+        INT32 NumberOfNotAir = 0;
+        BLOCK Top;
+        BOOL IsTopOpaque = FALSE;
+
+        /* Blocks are scanned from top, so first found block is highest (opaque blocks are preferred) */
+        for (INT32 y = CellSize - 1; y >= 0; y--)
+          for (INT32 z = 0; z < CellSize; z++)
+            for (INT32 x = 0; x < CellSize; x++)
+            {
+              UINT32 Index = GetIndex(glm::ivec3(CellX + x, CellY + y, CellZ + z));
+
+              if (Blocks.IsAir(Index))
+                continue;
+
+              if (NumberOfNotAir++ == 0 || (!IsTopOpaque && Blocks.IsOpaque(Index)))
+              {
+                Top = Blocks.Get(Index);
+                IsTopOpaque = Blocks.IsOpaque(Index);
+              }
+            }
+
+        if (NumberOfNotAir * 2 < CellSize * CellSize * CellSize)
+          continue;
+
+        for (INT32 y = 0; y < CellSize; y++)
+          for (INT32 z = 0; z < CellSize; z++)
+            for (INT32 x = 0; x < CellSize; x++)
+              Coarse.Set(GetIndex(glm::ivec3(CellX + x, CellY + y, CellZ + z)), Top);
+      }
+
+  Coarse.Compact();
+}
+
+/**
+ * \brief Get content hash of bytes function (64-bit FNV-1a)
+ * \param[in] Data Bytes
+ * \param[in] Size Number of bytes
+ * \param[in] Hash Hash of previous data (for hashing of several arrays)
+ * \return Hash
+ */
+UINT64 chunk_mesher::GetHash( const VOID *Data, UINT64 Size, UINT64 Hash )
+{
+  const BYTE *Bytes = reinterpret_cast<const BYTE *>(Data);
+
+  for (UINT64 i = 0; i < Size; i++)
+    Hash = (Hash ^ Bytes[i]) * 0x100000001b3ull;
+
+  return Hash;
+}
+
+/**
+ * \brief Save mesh to bytes array function
+ * \param[in, out] Bytes Array for appending serialized data
+ */
+VOID CHUNK_MESH_CACHE::Save( std::vector<BYTE> &Bytes ) const
+{
+  auto Write = [&Bytes]( const VOID *Data, UINT64 Size )
+  {
+    UINT64 Offset = Bytes.size();
+
+    /* Empty section has no quads array data */
+    if (Size == 0)
+      return;
+
+    Bytes.resize(Offset + Size);
+    memcpy(Bytes.data() + Offset, Data, Size);
+  };
+
+  /* Quads of per-face and greedy meshers differ */
+  UINT32 Format = Version << 1 | ENABLE_GREEDY_MESHING;
+  UINT64 BlockTypesHash = GetBlockTypesHash();
+
+  Write(&Format, sizeof(UINT32));
+  Write(&BlockTypesHash, sizeof(UINT64));
+  Write(&BlocksHash, sizeof(UINT64));
+  Write(&Lod, sizeof(UINT32));
+  Write(&BordersHash, sizeof(UINT64));
+
+  for (const std::vector<chunk_mesher::QUAD> &Quads : SectionQuads)
+  {
+    UINT32 NumberOfQuads = Quads.size();
+    UINT64 Offset;
+
+    Write(&NumberOfQuads, sizeof(UINT32));
+
+    Offset = Bytes.size();
+    Bytes.resize(Offset + Quads.size() * SavedQuadSize);
+
+    for (const chunk_mesher::QUAD &Quad : Quads)
+    {
+      SaveQuad(Quad, Bytes.data() + Offset);
+      Offset += SavedQuadSize;
+    }
+  }
+}
+
+/**
+ * \brief Load mesh from bytes array function
+ * \param[in] Bytes Serialized data
+ * \param[in] Size Serialized data size
+ * \return TRUE-if mesh is loaded, FALSE-if data is corrupted or saved by other mesher
+ */
+BOOL CHUNK_MESH_CACHE::Load( const BYTE *Bytes, UINT64 Size )
+{
+  UINT64 Offset = 0;
+
+  auto Read = [&]( VOID *Data, UINT64 DataSize )
+  {
+    if (Size - Offset < DataSize)
+      return FALSE;
+
+    if (DataSize > 0)
+      memcpy(Data, Bytes + Offset, DataSize);
+    Offset += DataSize;
+
+    return TRUE;
+  };
+
+  UINT32 Format = 0;
+  UINT64 BlockTypesHash = 0;
+
+  /* Texture indices and alphas of mesh saved with other block types are wrong */
+  if (!Read(&Format, sizeof(UINT32)) || Format != (Version << 1 | ENABLE_GREEDY_MESHING) ||
+      !Read(&BlockTypesHash, sizeof(UINT64)) || BlockTypesHash != GetBlockTypesHash() ||
+      !Read(&BlocksHash, sizeof(UINT64)) || !Read(&Lod, sizeof(UINT32)) || !Read(&BordersHash, sizeof(UINT64)))
+    return FALSE;
+
+  for (std::vector<chunk_mesher::QUAD> &Quads : SectionQuads)
+  {
+    UINT32 NumberOfQuads = 0;
+
+    if (!Read(&NumberOfQuads, sizeof(UINT32)) || (Size - Offset) / SavedQuadSize < NumberOfQuads)
+      return FALSE;
+
+    Quads.resize(NumberOfQuads);
+
+    for (chunk_mesher::QUAD &Quad : Quads)
+    {
+      if (!LoadQuad(Bytes + Offset, Quad))
+        return FALSE;
+      Offset += SavedQuadSize;
+    }
+  }
+
+  return Offset == Size;
+}
+
+/**
+ * \brief Get hash of block types data saved quads depend on function
+ * \return Hash of number of textures, face textures table and block types alphas
+ */
+UINT64 CHUNK_MESH_CACHE::GetBlockTypesHash( VOID )
+{
+  /* Texture indices are given by texture atlas in order of first use */
+  UINT64 NumberOfTextures = BLOCK_TYPE::TexRects.size();
+  UINT64 Hash = chunk_mesher::GetHash(&NumberOfTextures, sizeof(UINT64));
+
+  Hash = chunk_mesher::GetHash(BLOCK_TYPE::FaceTextures.data(), BLOCK_TYPE::FaceTextures.size() * sizeof(UINT32), Hash);
+
+  for (const BLOCK_TYPE &Type : BLOCK_TYPE::Table)
+    Hash = chunk_mesher::GetHash(&Type.Alpha, sizeof(FLT), Hash);
+
+  return Hash;
+}
+
+/**
+ * \brief Save quad function
+ * \param[in] Quad Quad description
+ * \param[out] Bytes Memory for SavedQuadSize bytes
+ */
+VOID CHUNK_MESH_CACHE::SaveQuad( const chunk_mesher::QUAD &Quad, BYTE *Bytes )
+{
+  for (UINT32 Axis = 0; Axis < 3; Axis++)
+  {
+    INT32 Coordinate = Quad.Origin[Axis];
+
+    memcpy(Bytes, &Coordinate, sizeof(INT32));
+    Bytes += sizeof(INT32);
+  }
+
+  *Bytes++ = Quad.Face;
+  *Bytes++ = Quad.SizeA;
+  *Bytes++ = Quad.SizeB;
+  memcpy(Bytes, &Quad.Texture, sizeof(UINT32));
+  memcpy(Bytes + sizeof(UINT32), &Quad.Alpha, sizeof(FLT));
+}
+
+/**
+ * \brief Load quad function
+ * \param[in] Bytes Memory with SavedQuadSize bytes
+ * \param[out] Quad Quad description
+ * \return TRUE-if quad is valid, FALSE-if it is out of chunk or has not existing face, size or texture
+ */
+BOOL CHUNK_MESH_CACHE::LoadQuad( const BYTE *Bytes, chunk_mesher::QUAD &Quad )
+{
+  for (UINT32 Axis = 0; Axis < 3; Axis++)
+  {
+    INT32 Coordinate;
+
+    memcpy(&Coordinate, Bytes, sizeof(INT32));
+    Bytes += sizeof(INT32);
+
+    if (Coordinate < 0 || Coordinate >= chunk_mesher::GetChunkSize(Axis))
+      return FALSE;
+    Quad.Origin[Axis] = Coordinate;
+  }
+
+  Quad.Face = *Bytes++;
+  Quad.SizeA = *Bytes++;
+  Quad.SizeB = *Bytes++;
+  memcpy(&Quad.Texture, Bytes, sizeof(UINT32));
+  memcpy(&Quad.Alpha, Bytes + sizeof(UINT32), sizeof(FLT));
+
+  /* Face indexes mesh arrays, texture indexes texture tables, sizes are packed to 4 bits */
+  return Quad.Face < BLOCK::NumberOfFaces && Quad.Texture < BLOCK_TYPE::TexCoords.size() &&
+         Quad.SizeA >= 1 && Quad.SizeA <= chunk_mesher::MaxQuadSize &&
+         Quad.SizeB >= 1 && Quad.SizeB <= chunk_mesher::MaxQuadSize && Quad.Alpha >= 0 && Quad.Alpha <= 1;
+}
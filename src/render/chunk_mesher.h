@@ -0,0 +1,444 @@
+#ifndef __chunk_mesher_h_
+#define __chunk_mesher_h_
+
+#include <vector>
+#include <array>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+#include "def.h"
+#include "vertex.h"
+#include "game_objects/chunk_blocks.h"
+#include "game_objects/chunk_pos.h"
+
+/**
+ * \brief Opacity of neighbour chunks layers adjacent to chunk structure
+ */
+struct CHUNK_BORDERS
+{
+  /** Opacity bits for every face direction (cell is block index without normal coordinate, empty - neighbour isn't loaded) */
+  std::array<std::vector<UINT64>, BLOCK::NumberOfFaces> Opaque;
+
+  /**
+   * \brief Check if neighbour block is opaque function
+   * \param[in] Face Face direction (BLOCK::Face* constant)
+   * \param[in] Cell Cell index in border
+   * \return TRUE if neighbour is loaded and its block is opaque
+   */
+  BOOL IsOpaque( UINT32 Face, UINT32 Cell ) const
+  {
+    return !Opaque[Face].empty() && ((Opaque[Face][Cell / 64] >> (Cell % 64)) & 1);
+  }
+
+  /**
+   * \brief Get opacity bits of several neighbour blocks function
+   * \param[in] Face Face direction (BLOCK::Face* constant)
+   * \param[in] Cell First cell index in border (aligned to number of cells)
+   * \param[in] Count Number of cells (power of 2, not greater than 64)
+   * \return Opacity bits (0 if neighbour isn't loaded)
+   */
+  UINT64 GetBits( UINT32 Face, UINT32 Cell, UINT32 Count ) const
+  {
+    if (Opaque[Face].empty())
+      return 0;
+
+    UINT64 Word = Opaque[Face][Cell / 64] >> (Cell % 64);
+
+    return Count == 64 ? Word : Word & ((1ull << Count) - 1);
+  }
+
+  /**
+   * \brief Get content hash of borders function
+   * \return Hash of opacity bits (empty and loaded borders differ)
+   */
+  UINT64 GetHash( VOID ) const;
+};
+
+/**
+ * \brief Chunk mesh structure (4 vertices per quad, quads are drawn with indices 0, 1, 2, 0, 2, 3)
+ *
+ * Vertex positions are relative to chunk origin, only face planes are in world coordinates.
+ *
+ * With vertex pulling quads are stored as packed faces (chunk_mesher::PackQuad) instead of vertices.
+ */
+struct CHUNK_MESH
+{
+  /** Opaque vertices for every face direction (faces of one direction are culled together) */
+  std::array<std::vector<VERTEX>, BLOCK::NumberOfFaces> Vertices;
+
+  /** Transparent vertices */
+  std::vector<VERTEX> TransparentVertices;
+
+  /** Opaque packed faces for every face direction */
+  std::array<std::vector<UINT32>, BLOCK::NumberOfFaces> Faces;
+
+  /** Transparent packed faces */
+  std::vector<UINT32> TransparentFaces;
+
+  /** Minimal and maximal world coordinates of opaque face planes along normal for every face direction */
+  std::array<glm::vec2, BLOCK::NumberOfFaces> FacePlanes;
+
+  /**
+   * \brief Chunk mesh constructor
+   */
+  CHUNK_MESH( VOID )
+  {
+    Clear();
+  }
+
+  /**
+   * \brief Get number of opaque quads function
+   * \return Number of quads in all face directions
+   */
+  UINT64 GetNumberOfQuads( VOID ) const;
+
+  /**
+   * \brief Get number of opaque quads of one face direction function
+   * \param[in] Face Face direction (BLOCK::Face* constant)
+   * \return Number of quads
+   */
+  UINT64 GetNumberOfQuads( UINT32 Face ) const
+  {
+    return Vertices[Face].size() / 4 + Faces[Face].size();
+  }
+
+  /**
+   * \brief Get number of transparent quads function
+   * \return Number of quads
+   */
+  UINT64 GetNumberOfTransparentQuads( VOID ) const
+  {
+    return TransparentVertices.size() / 4 + TransparentFaces.size();
+  }
+
+  /**
+   * \brief Clear mesh function
+   */
+  VOID Clear( VOID );
+};
+
+/**
+ * \brief CPU chunk mesher class (doesn't depend on render)
+ */
+class chunk_mesher
+{
+public:
+  /**
+   * \brief Face axes description structure
+   */
+  struct FACE_AXES
+  {
+    /** Normal axis */
+    UINT32 N;
+
+    /** First face axis (texture v-coordinate) */
+    UINT32 A;
+
+    /** Second face axis (texture u-coordinate) */
+    UINT32 B;
+  };
+
+  /** Axes for every face (same vertex order as original per-face geometry) */
+  static constexpr FACE_AXES FaceAxes[BLOCK::NumberOfFaces] =
+  {
+    {0, 1, 2}, // Left
+    {0, 1, 2}, // Right
+    {1, 0, 2}, // Down
+    {1, 0, 2}, // Up
+    {2, 1, 0}, // Back
+    {2, 1, 0}, // Front
+  };
+
+  /** Chunk sizes for every axis */
+  static constexpr INT32 ChunkSizes[3] = {chunk_blocks::ChunkSizeX, chunk_blocks::ChunkSizeY, chunk_blocks::ChunkSizeZ};
+
+  /**
+   * \brief Quad description structure
+   */
+  struct QUAD
+  {
+    /** Origin block position in chunk */
+    glm::ivec3 Origin;
+
+    /** Face index (BLOCK::Face* constant) */
+    UINT32 Face;
+
+    /** Size along first face axis (in blocks) */
+    UINT32 SizeA;
+
+    /** Size along second face axis (in blocks) */
+    UINT32 SizeB;
+
+    /** Texture index */
+    UINT32 Texture;
+
+    /** Alpha part */
+    FLT Alpha;
+  };
+
+  /**
+   * \brief Get face axes function
+   * \param[in] Face Face index (BLOCK::Face* constant)
+   * \return Face axes
+   */
+  static const FACE_AXES & GetFaceAxes( UINT32 Face );
+
+  /**
+   * \brief Get chunk size along axis function
+   * \param[in] Axis Axis index (0 - x, 1 - y, 2 - z)
+   * \return Chunk size
+   */
+  static INT32 GetChunkSize( UINT32 Axis );
+
+  /**
+   * \brief Get border cell of block function
+   * \param[in] Pos Block position in chunk
+   * \param[in] Face Face direction (BLOCK::Face* constant)
+   * \return Cell index in border
+   */
+  static UINT32 GetBorderCell( const glm::ivec3 &Pos, UINT32 Face );
+
+  /**
+   * \brief Get block of border cell function
+   * \param[in] Cell Cell index in border
+   * \param[in] Face Face direction (BLOCK::Face* constant)
+   * \return Position of chunk block adjacent to neighbour
+   */
+  static glm::ivec3 GetBorderPos( UINT32 Cell, UINT32 Face );
+
+  /**
+   * \brief Build neighbour border function
+   * \param[in] Neighbour Neighbour chunk blocks
+   * \param[in] Face Direction from chunk to neighbour (BLOCK::Face* constant)
+   * \param[out] Border Opacity bits of neighbour layer adjacent to chunk
+   */
+  static VOID GetBorder( const chunk_blocks &Neighbour, UINT32 Face, std::vector<UINT64> &Border );
+
+  /**
+   * \brief Check face visibility function
+   * \param[in] Blocks Blocks storage
+   * \param[in] Borders Neighbour borders
+   * \param[in] Pos Block position in chunk
+   * \param[in] Face Face index (BLOCK::Face* constant)
+   * \return TRUE if block isn't air and face isn't covered by opaque block
+   */
+  static BOOL IsFaceVisible( const chunk_blocks &Blocks, const CHUNK_BORDERS &Borders,
+                             const glm::ivec3 &Pos, UINT32 Face );
+
+  /** Face visibility mask (bit i is set if face of block i is visible) */
+  using VISIBILITY_MASK = std::array<UINT64, chunk_blocks::NumberOfBitsetWords>;
+
+  /**
+   * \brief Build face visibility mask for chunk rows function
+   *
+   * Every bitset word contains 4 rows along X-coordinate, so neighbours along X and Y are
+   * found by shifts of word, neighbours along Z are in other word with same bit position.
+   * \param[in] Blocks Blocks storage
+   * \param[in] Borders Neighbour borders
+   * \param[in] Face Face index (BLOCK::Face* constant)
+   * \param[out] Visible Face visibility mask (only words of occupied rows are filled)
+   * \param[in] MinY Minimal Y-coordinate of rows (multiple of 4)
+   * \param[in] MaxY Maximal Y-coordinate of rows
+   */
+  static VOID GetVisibilityMask( const chunk_blocks &Blocks, const CHUNK_BORDERS &Borders, UINT32 Face,
+                                 VISIBILITY_MASK &Visible, INT32 MinY = 0,
+                                 INT32 MaxY = chunk_blocks::ChunkSizeY - 1 );
+
+  /**
+   * \brief Build quad vertices function
+   * \param[in] Quad Quad description
+   * \param[out] Vertices 4 vertices (positions in chunk)
+   */
+  static VOID GetQuadVertices( const QUAD &Quad, VERTEX *Vertices );
+
+  /** Number of bits of texture index in packed face */
+  static constexpr UINT32 PackedTextureBits = 5;
+
+  /** Maximal quad size along face axis (size - 1 takes 4 bits in packed face) */
+  static constexpr UINT32 MaxQuadSize = 16;
+
+  /**
+   * \brief Pack quad to 32-bit face record function
+   *
+   * Bits: 0-3 - x, 4-11 - y, 12-15 - z (origin in chunk), 16-18 - face, 19-22 - size along first axis - 1,
+   * 23-26 - size along second axis - 1, 27-31 - texture index. Alpha is taken from texture by shader.
+   * \param[in] Quad Quad description
+   * \return Packed face
+   */
+  static UINT32 PackQuad( const QUAD &Quad );
+
+  /**
+   * \brief Build quads of one chunk section function
+   * \param[in] Blocks Blocks storage
+   * \param[in] Borders Neighbour borders
+   * \param[in] SectionId Section index (from bottom)
+   * \param[in, out] Quads Quads array (quads are appended)
+   * \param[in] Greedy Greedy meshing flag (quads don't cross section)
+   */
+  static VOID BuildSectionQuads( const chunk_blocks &Blocks, const CHUNK_BORDERS &Borders, UINT32 SectionId,
+                                 std::vector<QUAD> &Quads, BOOL Greedy = ENABLE_GREEDY_MESHING );
+
+  /**
+   * \brief Add quads to mesh function
+   * \param[in, out] Mesh Chunk mesh
+   * \param[in] Quads Quads array
+   * \param[in] ChunkPos Chunk position
+   */
+  static VOID AddQuads( CHUNK_MESH &Mesh, const std::vector<QUAD> &Quads, const CHUNK_POS &ChunkPos );
+
+  /**
+   * \brief Build chunk mesh function
+   * \param[in] Blocks Blocks storage
+   * \param[in] Borders Neighbour borders
+   * \param[in] ChunkPos Chunk position
+   * \param[out] Mesh Chunk mesh
+   * \param[in] Greedy Greedy meshing flag
+   */
+  static VOID Build( const chunk_blocks &Blocks, const CHUNK_BORDERS &Borders, const CHUNK_POS &ChunkPos,
+                     CHUNK_MESH &Mesh, BOOL Greedy = ENABLE_GREEDY_MESHING );
+
+  /** Number of levels of detail (level i is meshed from blocks downsampled 2^i times) */
+  static constexpr UINT32 NumberOfLods = 3;
+
+  /**
+   * \brief Downsample blocks for level of detail function
+   *
+   * Every cell of 2^Lod blocks along each axis is filled with its highest opaque (or, without opaque blocks,
+   * highest not air) block if at least half of cell isn't air, and is left air otherwise.
+   * Greedy meshing merges faces of filled cells.
+   * \param[in] Blocks Blocks storage
+   * \param[in] Lod Level of detail (less than NumberOfLods)
+   * \param[out] Coarse Downsampled blocks (must be empty)
+   */
+  static VOID Downsample( const chunk_blocks &Blocks, UINT32 Lod, chunk_blocks &Coarse );
+
+  /**
+   * \brief Get block index in chunk function
+   * \param[in] Pos Block position in chunk
+   * \return Block index
+   */
+  static UINT32 GetIndex( const glm::ivec3 &Pos )
+  {
+    return Pos.z * chunk_blocks::ChunkSizeY * chunk_blocks::ChunkSizeX + Pos.y * chunk_blocks::ChunkSizeX + Pos.x;
+  }
+
+  /** Maximal number of vertices addressed by 16-bit indices */
+  static constexpr UINT64 MaxNumberOfShortIndexVertices = 65536;
+
+  /**
+   * \brief Fill quad indices function (quad i uses vertices 4 * i .. 4 * i + 3 as two triangles)
+   * \param[out] Indices Indices array (6 indices per quad)
+   * \param[in] NumberOfQuads Number of quads
+   */
+  template<typename index_type>
+  static VOID FillQuadIndices( index_type *Indices, UINT64 NumberOfQuads )
+  {
+    constexpr UINT32 QuadIndices[6] = {0, 1, 2, 0, 2, 3};
+
+    for (UINT64 i = 0; i < NumberOfQuads; i++)
+      for (UINT32 j = 0; j < 6; j++)
+        Indices[i * 6 + j] = static_cast<index_type>(i * 4 + QuadIndices[j]);
+  }
+
+  /** Initial value of content hash */
+  static constexpr UINT64 HashBasis = 0xcbf29ce484222325ull;
+
+  /**
+   * \brief Get content hash of bytes function (64-bit FNV-1a)
+   * \param[in] Data Bytes
+   * \param[in] Size Number of bytes
+   * \param[in] Hash Hash of previous data (for hashing of several arrays)
+   * \return Hash
+   */
+  static UINT64 GetHash( const VOID *Data, UINT64 Size, UINT64 Hash = HashBasis );
+
+  /**
+   * \brief Get index of lowest set bit function
+   * \param[in] Bits Not zero word
+   * \return Bit index
+   */
+  static UINT32 GetLowestBit( UINT64 Bits )
+  {
+#ifdef _MSC_VER
+    unsigned long Index;
+
+    _BitScanForward64(&Index, Bits);
+    return Index;
+#else
+    return __builtin_ctzll(Bits);
+#endif
+  }
+
+private:
+  /**
+   * \brief Add quad to mesh function
+   * \param[in, out] Mesh Chunk mesh
+   * \param[in] Quad Quad description
+   * \param[in] ChunkPos Chunk position
+   */
+  static VOID AddQuad( CHUNK_MESH &Mesh, const QUAD &Quad, const CHUNK_POS &ChunkPos );
+};
+
+/**
+ * \brief Saved chunk mesh structure (reused instead of re-mesh while its key matches)
+ *
+ * Quads keep texture indices and alphas, so mesh is saved with hash of block types and dropped if they change.
+ */
+struct CHUNK_MESH_CACHE
+{
+  /** Format version (changed with mesher output) */
+  static constexpr UINT32 Version = 3;
+
+  /** Size of saved quad in bytes (origin, face, sizes, texture index and alpha without structure padding) */
+  static constexpr UINT32 SavedQuadSize = 3 * sizeof(INT32) + 3 * sizeof(BYTE) + sizeof(UINT32) + sizeof(FLT);
+
+  /** Hash of saved blocks data mesh was built from */
+  UINT64 BlocksHash = 0;
+
+  /** Level of detail mesh was built with */
+  UINT32 Lod = 0;
+
+  /** Hash of neighbour borders mesh was culled with (skirt borders are empty) */
+  UINT64 BordersHash = 0;
+
+  /** Quads of every section */
+  std::array<std::vector<chunk_mesher::QUAD>, chunk_blocks::NumberOfSections> SectionQuads;
+
+  /**
+   * \brief Save mesh to bytes array function
+   * \param[in, out] Bytes Array for appending serialized data
+   */
+  VOID Save( std::vector<BYTE> &Bytes ) const;
+
+  /**
+   * \brief Load mesh from bytes array function
+   * \param[in] Bytes Serialized data
+   * \param[in] Size Serialized data size
+   * \return TRUE-if mesh is loaded, FALSE-if data is corrupted or saved by other mesher
+   */
+  BOOL Load( const BYTE *Bytes, UINT64 Size );
+
+  /**
+   * \brief Get hash of block types data saved quads depend on function
+   * \return Hash of number of textures, face textures table and block types alphas
+   */
+  static UINT64 GetBlockTypesHash( VOID );
+
+  /**
+   * \brief Save quad function
+   * \param[in] Quad Quad description
+   * \param[out] Bytes Memory for SavedQuadSize bytes
+   */
+  static VOID SaveQuad( const chunk_mesher::QUAD &Quad, BYTE *Bytes );
+
+  /**
+   * \brief Load quad function
+   * \param[in] Bytes Memory with SavedQuadSize bytes
+   * \param[out] Quad Quad description
+   * \return TRUE-if quad is valid, FALSE-if it is out of chunk or has not existing face, size or texture
+   */
+  static BOOL LoadQuad( const BYTE *Bytes, chunk_mesher::QUAD &Quad );
+};
+
+#endif /* __chunk_mesher_h_ */
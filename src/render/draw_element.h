@@ -23,6 +23,26 @@ public:
    */
   virtual VkCommandBuffer GetTransparentCommandBuffer( VOID ) = 0;
 
+  /**
+   * \brief Update camera position function (called with render mutex locked)
+   * \param[in] CameraPos Camera position
+   * \return TRUE if command buffers of element were changed
+   */
+  virtual BOOL SetCameraPosition( const glm::vec3 &CameraPos )
+  {
+    return FALSE;
+  }
+
+  /**
+   * \brief Update render origin function (called with render mutex locked)
+   * \param[in] Origin World position of render origin
+   * \return TRUE if command buffers of element were changed
+   */
+  virtual BOOL SetRenderOrigin( const glm::ivec3 &Origin )
+  {
+    return FALSE;
+  }
+
   ///**
   // * \brief Update WVP function
   // */
@@ -0,0 +1,151 @@
+#include <algorithm>
+#include <array>
+#include <cfloat>
+
+#include "greedy_mesher.h"
+#include "game_objects/block_type.h"
+
+/**
+ * \brief Mesh one slice of one face direction function (direction is known at compile time)
+ * \param[in] Blocks Blocks storage
+ * \param[in] Visible Face visibility mask
+ * \param[in] Layer Layer along face normal
+ * \param[in, out] Quads Quads array (quads are appended)
+ * \param[in] Merge Merge opaque faces flag (FALSE - one quad per face)
+ * \param[in] MinY Minimal Y-coordinate of meshed blocks
+ * \param[in] MaxY Maximal Y-coordinate of meshed blocks
+ */
+template<UINT32 Face>
+VOID greedy_mesher::MeshFaceSlice( const chunk_blocks &Blocks, const chunk_mesher::VISIBILITY_MASK &Visible,
+                                   UINT32 Layer, std::vector<QUAD> &Quads, BOOL Merge, INT32 MinY, INT32 MaxY )
+{
+  constexpr chunk_mesher::FACE_AXES Axes = chunk_mesher::FaceAxes[Face];
+
+  INT32 MinA = 0, MaxA = chunk_mesher::ChunkSizes[Axes.A] - 1;
+  INT32 MinB = 0, MaxB = chunk_mesher::ChunkSizes[Axes.B] - 1;
+
+  /* Skip empty part of chunk above and below blocks */
+  MinY = std::max(MinY, Blocks.GetMinY());
+  MaxY = std::min(MaxY, Blocks.GetMaxY());
+
+  if constexpr (Axes.N == 1)
+    if ((INT32)Layer < MinY || (INT32)Layer > MaxY)
+      return;
+
+  if constexpr (Axes.A == 1)
+  {
+    MinA = std::max(MinA, MinY);
+    MaxA = std::min(MaxA, MaxY);
+  }
+
+  if (MinA > MaxA)
+    return;
+
+  UINT32 DimA = MaxA - MinA + 1;
+  UINT32 DimB = MaxB - MinB + 1;
+
+  /* Mask cell: 0 - no face, texture index + 1 otherwise */
+  std::array<UINT32, MaxSliceSize> Mask;
+
+  glm::ivec3 Pos(0);
+  Pos[Axes.N] = Layer;
+
+  for (UINT32 b = 0; b < DimB; b++)
+    for (UINT32 a = 0; a < DimA; a++)
+    {
+      Pos[Axes.A] = MinA + a;
+      Pos[Axes.B] = MinB + b;
+
+      UINT32 Index = chunk_mesher::GetIndex(Pos);
+
+      if (!((Visible[Index / 64] >> (Index % 64)) & 1))
+      {
+        Mask[b * DimA + a] = 0;
+        continue;
+      }
+
+      const BLOCK &Block = Blocks.Get(Index);
+      BOOL IsMergeable = Merge && BLOCK_TYPE::Table[Block.BlockTypeId].Alpha >= 1 - FLT_EPSILON;
+
+      Mask[b * DimA + a] = (BLOCK_TYPE::GetFaceTexture(Block, Face) + 1) | (IsMergeable ? 0 : NotMergeableBit);
+    }
+
+  for (UINT32 b = 0; b < DimB; b++)
+    for (UINT32 a = 0; a < DimA; a++)
+    {
+      UINT32 Cell = Mask[b * DimA + a];
+
+      if (Cell == 0)
+        continue;
+
+      UINT32 SizeA = 1, SizeB = 1;
+
+      if (!(Cell & NotMergeableBit))
+      {
+        while (a + SizeA < DimA && Mask[b * DimA + a + SizeA] == Cell)
+          SizeA++;
+
+        for (; b + SizeB < DimB; SizeB++)
+        {
+          UINT32 Row = (b + SizeB) * DimA + a;
+
+          if (!std::all_of(Mask.begin() + Row, Mask.begin() + Row + SizeA,
+                           [Cell]( UINT32 Other ){ return Other == Cell; }))
+            break;
+        }
+      }
+
+      for (UINT32 j = 0; j < SizeB; j++)
+        std::fill_n(Mask.begin() + (b + j) * DimA + a, SizeA, 0);
+
+      QUAD Quad;
+
+      Quad.Origin = Pos;
+      Quad.Origin[Axes.A] = MinA + a;
+      Quad.Origin[Axes.B] = MinB + b;
+      Quad.Face = Face;
+      Quad.SizeA = SizeA;
+      Quad.SizeB = SizeB;
+      Quad.Texture = (Cell & ~NotMergeableBit) - 1;
+      Quad.Alpha = BLOCK_TYPE::Table[Blocks.Get(chunk_mesher::GetIndex(Quad.Origin)).BlockTypeId].Alpha;
+
+      Quads.push_back(Quad);
+    }
+}
+
+/**
+ * \brief Mesh one slice by face visibility mask function
+ * \param[in] Blocks Blocks storage
+ * \param[in] Visible Face visibility mask (words of rows between MinY and MaxY must be filled)
+ * \param[in] Face Face index (BLOCK::Face* constant)
+ * \param[in] Layer Layer along face normal
+ * \param[in, out] Quads Quads array (quads are appended)
+ * \param[in] Merge Merge opaque faces flag (FALSE - one quad per face)
+ * \param[in] MinY Minimal Y-coordinate of meshed blocks
+ * \param[in] MaxY Maximal Y-coordinate of meshed blocks
+ */
+VOID greedy_mesher::MeshSlice( const chunk_blocks &Blocks, const chunk_mesher::VISIBILITY_MASK &Visible, UINT32 Face,
+                               UINT32 Layer, std::vector<QUAD> &Quads, BOOL Merge, INT32 MinY, INT32 MaxY )
+{
+  switch (Face)
+  {
+  case BLOCK::FaceLeft:
+    MeshFaceSlice<BLOCK::FaceLeft>(Blocks, Visible, Layer, Quads, Merge, MinY, MaxY);
+    break;
+  case BLOCK::FaceRight:
+    MeshFaceSlice<BLOCK::FaceRight>(Blocks, Visible, Layer, Quads, Merge, MinY, MaxY);
+    break;
+  case BLOCK::FaceDown:
+    MeshFaceSlice<BLOCK::FaceDown>(Blocks, Visible, Layer, Quads, Merge, MinY, MaxY);
+    break;
+  case BLOCK::FaceUp:
+    MeshFaceSlice<BLOCK::FaceUp>(Blocks, Visible, Layer, Quads, Merge, MinY, MaxY);
+    break;
+  case BLOCK::FaceBack:
+    MeshFaceSlice<BLOCK::FaceBack>(Blocks, Visible, Layer, Quads, Merge, MinY, MaxY);
+    break;
+  default:
+    MeshFaceSlice<BLOCK::FaceFront>(Blocks, Visible, Layer, Quads, Merge, MinY, MaxY);
+    break;
+  }
+}
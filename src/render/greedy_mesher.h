@@ -0,0 +1,61 @@
+#ifndef __greedy_mesher_h_
+#define __greedy_mesher_h_
+
+#include <vector>
+#include <algorithm>
+
+#include "def.h"
+#include "chunk_mesher.h"
+
+/**
+ * \brief Greedy chunk mesher class
+ *
+ * Merges adjacent coplanar visible faces with same texture and alpha into larger quads.
+ * Chunk is meshed by slices (one face direction and one layer along face normal),
+ * slice can be bounded by Y-range, so quads don't cross chunk sections.
+ * Visibility of faces is taken from bitwise visibility mask which is built once for all slices of direction.
+ */
+class greedy_mesher
+{
+public:
+  /** Quad description */
+  using QUAD = chunk_mesher::QUAD;
+
+  /**
+   * \brief Mesh one slice by face visibility mask function
+   * \param[in] Blocks Blocks storage
+   * \param[in] Visible Face visibility mask (words of rows between MinY and MaxY must be filled)
+   * \param[in] Face Face index (BLOCK::Face* constant)
+   * \param[in] Layer Layer along face normal
+   * \param[in, out] Quads Quads array (quads are appended)
+   * \param[in] Merge Merge opaque faces flag (FALSE - one quad per face)
+   * \param[in] MinY Minimal Y-coordinate of meshed blocks
+   * \param[in] MaxY Maximal Y-coordinate of meshed blocks
+   */
+  static VOID MeshSlice( const chunk_blocks &Blocks, const chunk_mesher::VISIBILITY_MASK &Visible, UINT32 Face,
+                         UINT32 Layer, std::vector<QUAD> &Quads, BOOL Merge = TRUE, INT32 MinY = 0,
+                         INT32 MaxY = chunk_blocks::ChunkSizeY - 1 );
+
+private:
+  /** Mask flag for faces which can't be merged */
+  static constexpr UINT32 NotMergeableBit = 0x80000000;
+
+  /** Maximal number of cells in slice */
+  static constexpr UINT32 MaxSliceSize = chunk_blocks::ChunkSizeY * std::max(chunk_blocks::ChunkSizeX, chunk_blocks::ChunkSizeZ);
+
+  /**
+   * \brief Mesh one slice of one face direction function (direction is known at compile time)
+   * \param[in] Blocks Blocks storage
+   * \param[in] Visible Face visibility mask
+   * \param[in] Layer Layer along face normal
+   * \param[in, out] Quads Quads array (quads are appended)
+   * \param[in] Merge Merge opaque faces flag (FALSE - one quad per face)
+   * \param[in] MinY Minimal Y-coordinate of meshed blocks
+   * \param[in] MaxY Maximal Y-coordinate of meshed blocks
+   */
+  template<UINT32 Face>
+  static VOID MeshFaceSlice( const chunk_blocks &Blocks, const chunk_mesher::VISIBILITY_MASK &Visible, UINT32 Layer,
+                             std::vector<QUAD> &Quads, BOOL Merge, INT32 MinY, INT32 MaxY );
+};
+
+#endif /* __greedy_mesher_h_ */
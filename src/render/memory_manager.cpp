@@ -1,18 +1,22 @@
+#include <string>
+
 #include "memory_manager.h"
 #include "vulkan_wrappers/command_buffer.h"
 
 /**
  * \brief Memory manager constructor
- * \param[in] MaxNumberOfChunks Maximal number of chunks
- * \param[in] ChunkVertexSize Maximal chunk vertex buffer size in bytes
- * \param[in] ChunkIndexSize Maximal chunk index buffer size in bytes
+ * \param[in] VertexSize Vertex buffer size in bytes (shared by all chunks)
+ * \param[in] VertexGranularity Vertex buffer allocation unit in bytes (offsets are multiple of it)
+ * \param[in] IndexSize Index buffer size in bytes (index buffer is shared by all chunks)
  * \param[in] MaxTransferSize Maximal transfer operation size
  * \param[in] UniformSize Uniform buffer size
  * \param[in, out] Synchronization Synchronization object
  */
-memory_manager::memory_manager( vulkan_application &VkApp, UINT32 MaxNumberOfChunks, UINT64 ChunkVertexSize,
-                                UINT64 ChunkIndexSize, UINT64 MaxTransferSize, UINT64 UniformSize,
-                                render_synchronization &Synchronization ) : VkApp(VkApp), Synchronization(Synchronization)
+memory_manager::memory_manager( vulkan_application &VkApp, UINT64 VertexSize, UINT64 VertexGranularity,
+                                UINT64 IndexSize, UINT64 MaxTransferSize, UINT64 UniformSize,
+                                render_synchronization &Synchronization ) :
+  VertexGranularity(VertexGranularity), VertexAllocator(VertexSize / VertexGranularity), VkApp(VkApp),
+  Synchronization(Synchronization)
 {
   UniformBuffer = buffer(VkApp.GetDeviceId(), UniformSize,
                          VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
@@ -33,10 +37,9 @@ memory_manager::memory_manager( vulkan_application &VkApp, UINT32 MaxNumberOfChu
 
   UniformBuffer.BindMemory(UniformMemory, 0);
 
-  UINT64 VertexSize = ChunkVertexSize * MaxNumberOfChunks;
-
   VertexBuffer = buffer(VkApp.GetDeviceId(), VertexSize,
-    VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+    VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT |
+    VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
     0, VK_SHARING_MODE_EXCLUSIVE, 0, nullptr);
 
   VkMemoryRequirements VertexMemoryRequirements = VertexBuffer.GetMemoryRequirements();
@@ -54,8 +57,6 @@ memory_manager::memory_manager( vulkan_application &VkApp, UINT32 MaxNumberOfChu
 
   VertexBuffer.BindMemory(VertexMemory, 0);
 
-  UINT64 IndexSize = ChunkVertexSize * MaxNumberOfChunks;
-
   IndexBuffer = buffer(VkApp.GetDeviceId(), IndexSize,
                        VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
                        0, VK_SHARING_MODE_EXCLUSIVE, 0, nullptr);
@@ -108,36 +109,52 @@ memory_manager::memory_manager( vulkan_application &VkApp, UINT32 MaxNumberOfChu
   SmallUpdateFence = fence(VkApp.GetDeviceId(), FALSE);
   PushFence = fence(VkApp.GetDeviceId(), FALSE);
   CopyFence = fence(VkApp.GetDeviceId(), FALSE);
-
-  for (UINT32 i = 0; i < MaxNumberOfChunks; i++)
-    FreeChunks.insert(i);
 }
 
 /**
- * \brief Allocate chunk
- * \return Allocate memory index
+ * \brief Allocate vertex buffer range function
+ * \param[in] Size Range size in bytes
+ * \param[out] Offset Range offset in vertex buffer
+ * \return Range index for FreeVertices or std::nullopt if vertex buffer has no free range of such size
  */
-UINT32 memory_manager::AllocateChunk( VOID )
+std::optional<UINT32> memory_manager::AllocateVertices( UINT64 Size, UINT64 &Offset )
 {
-  if (FreeChunks.size() > 0)
-  {
-    UINT32 Res = *FreeChunks.begin();
+  std::lock_guard<std::mutex> Lock(VertexAllocatorMutex);
 
-    FreeChunks.erase(FreeChunks.begin());
+  std::optional<UINT32> RangeId = VertexAllocator.Allocate((Size + VertexGranularity - 1) / VertexGranularity);
 
-    return Res;
-  }
-  else
-    throw std::runtime_error("free chunks not found");
+  if (RangeId)
+    Offset = VertexAllocator.GetOffset(*RangeId) * VertexGranularity;
+
+  return RangeId;
 }
 
 /**
- * \brief Free chunk
- * \return Free memory index
+ * \brief Free vertex buffer range function
+ * \param[in] RangeId Range index
  */
-VOID memory_manager::FreeChunk( UINT32 ChunkId )
+VOID memory_manager::FreeVertices( UINT32 RangeId )
 {
-  FreeChunks.insert(ChunkId);
+  std::lock_guard<std::mutex> Lock(VertexAllocatorMutex);
+
+  VertexAllocator.Free(RangeId);
+}
+
+/**
+ * \brief Get vertex buffer allocation statistics function
+ * \return Statistics (sizes in bytes)
+ */
+range_allocator::STATS memory_manager::GetVertexStats( VOID )
+{
+  std::lock_guard<std::mutex> Lock(VertexAllocatorMutex);
+
+  range_allocator::STATS Stats = VertexAllocator.GetStats();
+
+  Stats.Capacity *= VertexGranularity;
+  Stats.AllocatedSize *= VertexGranularity;
+  Stats.LargestFreeRange *= VertexGranularity;
+
+  return Stats;
 }
 
 /**
@@ -1,9 +1,11 @@
 #ifndef __memory_manager_h_
 #define __memory_manager_h_
 
-#include <set>
+#include <mutex>
+#include <optional>
 
 #include "def.h"
+#include "utils/range_allocator.h"
 #include "vulkan_wrappers/vulkan_application.h"
 #include "vulkan_wrappers/memory.h"
 #include "vulkan_wrappers/buffer.h"
@@ -20,15 +22,15 @@ class memory_manager
 public:
   /**
    * \brief Memory manager constructor
-   * \param[in] MaxNumberOfChunks Maximal number of chunks
-   * \param[in] ChunkVertexSize Maximal chunk vertex buffer size in bytes
-   * \param[in] ChunkIndexSize Maximal chunk index buffer size in bytes
+   * \param[in] VertexSize Vertex buffer size in bytes (shared by all chunks)
+   * \param[in] VertexGranularity Vertex buffer allocation unit in bytes (offsets are multiple of it)
+   * \param[in] IndexSize Index buffer size in bytes (index buffer is shared by all chunks)
    * \param[in] MaxTransferSize Maximal transfer operation size
    * \param[in] UniformSize Uniform buffer size
    * \param[in, out] Synchronization Synchronization object
    */
-  memory_manager( vulkan_application &VkApp, UINT32 MaxNumberOfChunks,
-                  UINT64 ChunkVertexSize, UINT64 ChunkIndexSize,
+  memory_manager( vulkan_application &VkApp, UINT64 VertexSize,
+                  UINT64 VertexGranularity, UINT64 IndexSize,
                   UINT64 MaxTransferSize, UINT64 UniformSize,
                   render_synchronization &Synchronization );
 
@@ -106,16 +108,24 @@ public:
                    VkFlags SrcAccess, VkFlags DstAccess ) const;
 
   /**
-   * \brief Allocate chunk
-   * \return Allocate memory index
+   * \brief Allocate vertex buffer range function
+   * \param[in] Size Range size in bytes
+   * \param[out] Offset Range offset in vertex buffer
+   * \return Range index for FreeVertices or std::nullopt if vertex buffer has no free range of such size
    */
-  UINT32 AllocateChunk( VOID );
+  std::optional<UINT32> AllocateVertices( UINT64 Size, UINT64 &Offset );
 
   /**
-   * \brief Free chunk
-   * \return Free memory index
+   * \brief Free vertex buffer range function
+   * \param[in] RangeId Range index
    */
-  VOID FreeChunk( UINT32 ChunkId );
+  VOID FreeVertices( UINT32 RangeId );
+
+  /**
+   * \brief Get vertex buffer allocation statistics function
+   * \return Statistics (sizes in bytes)
+   */
+  range_allocator::STATS GetVertexStats( VOID );
 
   /** Vertex memory don't visible from CPU flag */
   BOOL NeedCopyVertex = FALSE;
@@ -141,7 +151,7 @@ public:
   /** Vertex buffer */
   buffer VertexBuffer;
 
-  /** Index buffer */
+  /** Index buffer (quad indices shared by all chunks) */
   buffer IndexBuffer;
 
   /** Buffer for transfer data from CPU to GPU */
@@ -151,8 +161,14 @@ public:
   buffer UniformBuffer;
 
 private:
-  /** Free chunks set */
-  std::set<UINT32> FreeChunks;
+  /** Vertex buffer allocation unit in bytes */
+  UINT64 VertexGranularity;
+
+  /** Vertex buffer ranges allocator (in allocation units) */
+  range_allocator VertexAllocator;
+
+  /** Vertex allocator mutex (ranges are allocated by upload thread and freed with old geometries) */
+  std::mutex VertexAllocatorMutex;
 
   /** Reference to vulkan application */
   vulkan_application &VkApp;
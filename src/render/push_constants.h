@@ -0,0 +1,28 @@
+#ifndef __push_constants_h_
+#define __push_constants_h_
+
+#include "def.h"
+
+/**
+ * \brief Push constants structure (pushed by every chunk)
+ */
+struct push_constants
+{
+public:
+  /** Position of chunk origin relative to render origin */
+  glm::vec3 ChunkOrigin;
+
+  /** Index of first chunk face in faces storage buffer (only for vertex pulling) */
+  UINT32 FirstFace;
+
+private:
+  /**
+   * \brief Compile-time test
+   */
+  static VOID LayoutTest( VOID )
+  {
+    static_assert(sizeof(push_constants) == 16);
+  }
+};
+
+#endif /* __push_constants_h_ */
@@ -3,6 +3,8 @@
 #include <cstddef>
 #include <optional>
 #include <numeric>
+#include <algorithm>
+#include <cmath>
 
 #include "vulkan_wrappers/vulkan_application.h"
 #include "vulkan_wrappers/graphics_pipeline.h"
@@ -25,6 +27,9 @@
 #include "glfw_window.h"
 #include "render.h"
 #include "vertex.h"
+#include "push_constants.h"
+#include "chunk_mesher.h"
+#include "game_objects/block_type.h"
 
 /**
  * \brief Create render function
@@ -86,11 +91,30 @@ render::render( vulkan_application &VkApp, const glfw_surface &Surface, UINT32 M
   }
 
   //AppliedMatrWVP = Camera.ViewProjMatrix;
+  FillTextureTable();
   UpdateWVP();
 
   CreateCommandBuffers();
 }
 
+/**
+ * \brief Fill texture table in uniform buffer function
+ */
+VOID render::FillTextureTable( VOID )
+{
+  static_assert(1 << chunk_mesher::PackedTextureBits == uniform_buffer::MaxNumberOfTextures);
+
+  if (BLOCK_TYPE::TexRects.size() > uniform_buffer::MaxNumberOfTextures)
+    throw std::runtime_error("too many textures for texture table");
+
+  for (UINT32 i = 0; i < BLOCK_TYPE::TexRects.size(); i++)
+    UniformBufferData.TexRects[i] = BLOCK_TYPE::TexRects[i];
+
+  for (const BLOCK_TYPE &Type : BLOCK_TYPE::Table)
+    for (UINT32 Texture : Type.Textures)
+      UniformBufferData.TexAlphas[Texture / 4][Texture % 4] = Type.Alpha;
+}
+
 /**
  * \brief Create render pass function
  */
@@ -158,7 +182,11 @@ VOID render::CreateRenderPass( VOID )
  */
 VOID render::CreateDefaultGraphicsPipeline( VOID )
 {
+#if ENABLE_VERTEX_PULLING
+  DefaultVertexShader = shader_module(VkApp.GetDeviceId(), "shaders-build/default/packed_face.vert.spv");
+#else /* ENABLE_VERTEX_PULLING */
   DefaultVertexShader = shader_module(VkApp.GetDeviceId(), "shaders-build/default/shader.vert.spv");
+#endif /* ENABLE_VERTEX_PULLING */
   DefaultFragmentShader = shader_module(VkApp.GetDeviceId(), "shaders-build/default/shader.frag.spv");
 
   VkPipelineShaderStageCreateInfo ShaderStageCreateInfos[2] = {};
@@ -185,11 +213,11 @@ VOID render::CreateDefaultGraphicsPipeline( VOID )
   BindingDescription.stride = sizeof(VERTEX);
   BindingDescription.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
 
-  VkVertexInputAttributeDescription AttributeDescriptions[3] = {};
+  VkVertexInputAttributeDescription AttributeDescriptions[4] = {};
 
   AttributeDescriptions[0].location = 0;
   AttributeDescriptions[0].binding = 0;
-  AttributeDescriptions[0].format = VK_FORMAT_R32G32B32_SFLOAT;
+  AttributeDescriptions[0].format = VK_FORMAT_R32_UINT;
   AttributeDescriptions[0].offset = offsetof(VERTEX, Position);
 
   AttributeDescriptions[1].location = 1;
@@ -202,15 +230,28 @@ VOID render::CreateDefaultGraphicsPipeline( VOID )
   AttributeDescriptions[2].format = VK_FORMAT_R32G32_SFLOAT;
   AttributeDescriptions[2].offset = offsetof(VERTEX, TexCoord);
 
+  AttributeDescriptions[3].location = 3;
+  AttributeDescriptions[3].binding = 0;
+  AttributeDescriptions[3].format = VK_FORMAT_R32_UINT;
+  AttributeDescriptions[3].offset = offsetof(VERTEX, Texture);
+
   VkPipelineVertexInputStateCreateInfo VertexInputStateCreateInfo = {};
 
   VertexInputStateCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
   VertexInputStateCreateInfo.pNext = nullptr;
   VertexInputStateCreateInfo.flags = 0;
+#if ENABLE_VERTEX_PULLING
+  /* Vertices are built in shader from packed faces */
+  VertexInputStateCreateInfo.vertexBindingDescriptionCount = 0;
+  VertexInputStateCreateInfo.pVertexBindingDescriptions = nullptr;
+  VertexInputStateCreateInfo.vertexAttributeDescriptionCount = 0;
+  VertexInputStateCreateInfo.pVertexAttributeDescriptions = nullptr;
+#else /* ENABLE_VERTEX_PULLING */
   VertexInputStateCreateInfo.vertexBindingDescriptionCount = 1;
   VertexInputStateCreateInfo.pVertexBindingDescriptions = &BindingDescription;
-  VertexInputStateCreateInfo.vertexAttributeDescriptionCount = 3;
+  VertexInputStateCreateInfo.vertexAttributeDescriptionCount = 4;
   VertexInputStateCreateInfo.pVertexAttributeDescriptions = AttributeDescriptions;
+#endif /* ENABLE_VERTEX_PULLING */
 
   VkPipelineInputAssemblyStateCreateInfo InputAssemblyStateCreateInfo = {};
 
@@ -317,7 +358,7 @@ VOID render::CreateDefaultGraphicsPipeline( VOID )
   ColorBlendStateCreateInfo.blendConstants[2] = 0;
   ColorBlendStateCreateInfo.blendConstants[3] = 0;
 
-  VkDescriptorSetLayoutBinding LayoutBindings[2] = {};
+  VkDescriptorSetLayoutBinding LayoutBindings[NumberOfDescriptors] = {};
 
   LayoutBindings[0].binding = 0;
   LayoutBindings[0].pImmutableSamplers = nullptr;
@@ -331,7 +372,15 @@ VOID render::CreateDefaultGraphicsPipeline( VOID )
   LayoutBindings[1].descriptorCount = 1;
   LayoutBindings[1].stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
 
-  DefaultDescriptorSetLayout = descriptor_set_layout(VkApp.GetDeviceId(), 2, LayoutBindings);
+#if ENABLE_VERTEX_PULLING
+  LayoutBindings[2].binding = 2;
+  LayoutBindings[2].pImmutableSamplers = nullptr;
+  LayoutBindings[2].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+  LayoutBindings[2].descriptorCount = 1;
+  LayoutBindings[2].stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+#endif /* ENABLE_VERTEX_PULLING */
+
+  DefaultDescriptorSetLayout = descriptor_set_layout(VkApp.GetDeviceId(), NumberOfDescriptors, LayoutBindings);
   VkDescriptorSetLayout DescriptorSetLayoutId = DefaultDescriptorSetLayout.GetSetLayoutId();
 
  //VkPushConstantRange MatrWVPPushConstantRange = {};
@@ -340,8 +389,15 @@ VOID render::CreateDefaultGraphicsPipeline( VOID )
  //MatrWVPPushConstantRange.offset = 0;
  //MatrWVPPushConstantRange.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
 
+  /* Chunk origin relative to render origin (and first face for vertex pulling) is pushed by every chunk */
+  VkPushConstantRange PushConstantRange = {};
+
+  PushConstantRange.size = sizeof(push_constants);
+  PushConstantRange.offset = 0;
+  PushConstantRange.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+
   DefaultPipelineLayout =
-    pipeline_layout(VkApp.GetDeviceId(), 1, &DescriptorSetLayoutId, 0, nullptr/*1, &MatrWVPPushConstantRange*/);
+    pipeline_layout(VkApp.GetDeviceId(), 1, &DescriptorSetLayoutId, 1, &PushConstantRange);
 
   pipeline_cache EmptyCache;
 
@@ -358,7 +414,7 @@ VOID render::CreateDefaultGraphicsPipeline( VOID )
  */
 VOID render::CreateDescriptorPoolAndAllocateSets( VOID )
 {
-  VkDescriptorPoolSize DescriptorPoolSizes[2];
+  VkDescriptorPoolSize DescriptorPoolSizes[NumberOfDescriptors];
 
   DescriptorPoolSizes[0].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
   DescriptorPoolSizes[0].descriptorCount = 1;
@@ -366,8 +422,13 @@ VOID render::CreateDescriptorPoolAndAllocateSets( VOID )
   DescriptorPoolSizes[1].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
   DescriptorPoolSizes[1].descriptorCount = 1;
 
+#if ENABLE_VERTEX_PULLING
+  DescriptorPoolSizes[2].type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+  DescriptorPoolSizes[2].descriptorCount = 1;
+#endif /* ENABLE_VERTEX_PULLING */
+
   DefaultDescriptorPool =
-    descriptor_pool(VkApp.GetDeviceId(), 0, 1, 2, DescriptorPoolSizes);
+    descriptor_pool(VkApp.GetDeviceId(), 0, 1, NumberOfDescriptors, DescriptorPoolSizes);
 
   VkDescriptorSetLayout DescriptorSetsLayout[1] =
   {
@@ -382,7 +443,7 @@ VOID render::CreateDescriptorPoolAndAllocateSets( VOID )
  */
 VOID render::WriteDescriptorSets( VOID )
 {
-  VkWriteDescriptorSet WriteDescriptorSetStructures[2] = {};
+  VkWriteDescriptorSet WriteDescriptorSetStructures[NumberOfDescriptors] = {};
 
   VkDescriptorImageInfo ImageInfos[1] = {};
 
@@ -401,7 +462,7 @@ VOID render::WriteDescriptorSets( VOID )
   WriteDescriptorSetStructures[0].pBufferInfo = nullptr;
   WriteDescriptorSetStructures[0].pTexelBufferView = nullptr;
 
-  VkDescriptorBufferInfo BufferInfos[1] = {};
+  VkDescriptorBufferInfo BufferInfos[NumberOfDescriptors - 1] = {};
 
   BufferInfos[0].buffer = MemoryManager.UniformBuffer.GetBufferId();
   BufferInfos[0].offset = 0;
@@ -418,7 +479,25 @@ VOID render::WriteDescriptorSets( VOID )
   WriteDescriptorSetStructures[1].pBufferInfo = &BufferInfos[0];
   WriteDescriptorSetStructures[1].pTexelBufferView = nullptr;
 
-  vkUpdateDescriptorSets(VkApp.GetDeviceId(), 2, WriteDescriptorSetStructures, 0, nullptr);
+#if ENABLE_VERTEX_PULLING
+  /* Packed faces of all chunks, chunk selects its faces by push constant */
+  BufferInfos[1].buffer = MemoryManager.VertexBuffer.GetBufferId();
+  BufferInfos[1].offset = 0;
+  BufferInfos[1].range = VK_WHOLE_SIZE;
+
+  WriteDescriptorSetStructures[2].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+  WriteDescriptorSetStructures[2].pNext = nullptr;
+  WriteDescriptorSetStructures[2].dstSet = DefaultDescriptorSet;
+  WriteDescriptorSetStructures[2].dstBinding = 2;
+  WriteDescriptorSetStructures[2].dstArrayElement = 0;
+  WriteDescriptorSetStructures[2].descriptorCount = 1;
+  WriteDescriptorSetStructures[2].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+  WriteDescriptorSetStructures[2].pImageInfo = nullptr;
+  WriteDescriptorSetStructures[2].pBufferInfo = &BufferInfos[1];
+  WriteDescriptorSetStructures[2].pTexelBufferView = nullptr;
+#endif /* ENABLE_VERTEX_PULLING */
+
+  vkUpdateDescriptorSets(VkApp.GetDeviceId(), NumberOfDescriptors, WriteDescriptorSetStructures, 0, nullptr);
 }
 
 /**
@@ -539,7 +618,7 @@ VOID render::CreateDepthBuffer( VOID )
 }
 
 /**
- * \brief Get secondary command buffer function
+ * \brief Get secondary command buffer function (render mutex must be locked)
  * \return New command buffer
  */
 VkCommandBuffer render::GetSecondaryCommandBuffer( VOID )
@@ -552,7 +631,7 @@ VkCommandBuffer render::GetSecondaryCommandBuffer( VOID )
 }
 
 /**
- * \brief Revert secondary command buffer function
+ * \brief Revert secondary command buffer function (render mutex must be locked)
  * \param[in] CommandBuffer Buffer for return in pool
  */
 VOID render::ReturnSecondaryCommandBuffer( VkCommandBuffer CommandBuffer )
@@ -760,7 +839,9 @@ render::~render( VOID )
  */
 VOID render::UpdateWVP( const glm::mat4 &World )
 {
-  UniformBufferData.MatrWVP = Camera.ViewProjMatrix * World;
+  /* World matrix places element in world coordinates, so it is moved to render origin first */
+  UniformBufferData.MatrWVP = Camera.GetViewProjMatrix(RenderOrigin) *
+    glm::translate(glm::mat4(1), -glm::vec3(RenderOrigin)) * World;
 
   MemoryManager.SmallUpdateBuffer(MemoryManager.UniformBuffer, 0, sizeof(uniform_buffer),
     reinterpret_cast<BYTE *>(&UniformBufferData),
@@ -819,7 +900,34 @@ VOID render::UpdateWVP( const glm::mat4 &World )
  */
 VOID render::UpdateWVP( VOID )
 {
-  UniformBufferData.MatrWVP = Camera.ViewProjMatrix;
+  {
+    /* Elements cull their geometry by camera position, so moved camera can change their command buffers */
+    std::lock_guard<std::mutex> Lock(Synchronization.RenderMutex);
+    BOOL IsChanged = FALSE;
+
+    CameraPosition = Camera.Loc;
+
+    /* Floating origin: origin follows camera, so coordinates relative to it stay small at any distance */
+    glm::vec3 OriginOffset = CameraPosition - glm::vec3(RenderOrigin);
+
+    if (std::max({std::abs(OriginOffset.x), std::abs(OriginOffset.y), std::abs(OriginOffset.z)}) > MaxOriginDistance)
+    {
+      RenderOrigin = glm::ivec3(std::floor(CameraPosition.x), std::floor(CameraPosition.y),
+                                std::floor(CameraPosition.z));
+
+      for (draw_element *Element : DrawElements)
+        IsChanged |= Element->SetRenderOrigin(RenderOrigin);
+    }
+
+    for (draw_element *Element : DrawElements)
+      IsChanged |= Element->SetCameraPosition(CameraPosition);
+
+    if (IsChanged)
+      UpdateCommandBuffers();
+  }
+
+  /* Frames are rendered by same thread, so new command buffers and matrix are used from same frame */
+  UniformBufferData.MatrWVP = Camera.GetViewProjMatrix(RenderOrigin);
 
   MemoryManager.SmallUpdateBuffer(MemoryManager.UniformBuffer, 0, sizeof(uniform_buffer),
                                   reinterpret_cast<BYTE *>(&UniformBufferData),
@@ -880,20 +988,7 @@ VOID render::UpdateWVP( VOID )
  */
 VOID render::AddDrawElement( draw_element *Element )
 {
-  std::lock_guard<std::mutex> Lock(Synchronization.RenderMutex);
-
-  DrawElements.insert(Element);
-
-  SecondaryCommandBuffersVector.clear();
-  SecondaryCommandBuffersVector.reserve(DrawElements.size());
-
-  for (draw_element *Element : DrawElements)
-    SecondaryCommandBuffersVector.push_back(Element->GetCommandBuffer());
-
-  for (draw_element *Element : DrawElements)
-    SecondaryCommandBuffersVector.push_back(Element->GetTransparentCommandBuffer());
-
-  UpdateCommandBuffers();
+  ReplaceDrawElement(nullptr, Element);
 }
 
 /**
@@ -913,17 +1008,39 @@ VOID render::UpdateCommandBuffers( VOID )
  */
 VOID render::DeleteDrawElement( draw_element *Element )
 {
+  ReplaceDrawElement(Element, nullptr);
+}
+
+/**
+ * \brief Replace draw element function (command buffers are rebuilt once, between frames)
+ * \param[in] OldElement Pointer to replaced element (nullptr - only add new element)
+ * \param[in] NewElement Pointer to new element (nullptr - only delete old element)
+ */
+VOID render::ReplaceDrawElement( draw_element *OldElement, draw_element *NewElement )
+{
+  /* Frame is submitted and waited under render mutex, so old element isn't used by GPU after swap */
   std::lock_guard<std::mutex> Lock(Synchronization.RenderMutex);
 
-  std::set<draw_element *>::iterator It = DrawElements.find(Element);
+  if (OldElement != nullptr)
+  {
+    std::set<draw_element *>::iterator It = DrawElements.find(OldElement);
+
+    if (It == DrawElements.end())
+      throw std::runtime_error("element not found");
 
-  if (It == DrawElements.end())
-    throw std::runtime_error("element not found");
+    DrawElements.erase(It);
+  }
 
-  DrawElements.erase(It);
+  if (NewElement != nullptr)
+  {
+    /* Camera could move (and render origin could change) after element was created */
+    NewElement->SetRenderOrigin(RenderOrigin);
+    NewElement->SetCameraPosition(CameraPosition);
+    DrawElements.insert(NewElement);
+  }
 
   SecondaryCommandBuffersVector.clear();
-  SecondaryCommandBuffersVector.reserve(DrawElements.size());
+  SecondaryCommandBuffersVector.reserve(DrawElements.size() * 2);
 
   for (draw_element *Element : DrawElements)
     SecondaryCommandBuffersVector.push_back(Element->GetCommandBuffer());
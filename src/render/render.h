@@ -54,13 +54,13 @@ public:
   VOID CreateCommandBuffers( VOID );
 
   /**
-   * \brief Get secondary command buffer function
+   * \brief Get secondary command buffer function (render mutex must be locked)
    * \return New command buffer
    */
   VkCommandBuffer GetSecondaryCommandBuffer( VOID );
 
   /**
-   * \brief Revert secondary command buffer function
+   * \brief Revert secondary command buffer function (render mutex must be locked)
    * \param[in] CommandBuffer Buffer for return in pool
    */
   VOID ReturnSecondaryCommandBuffer( VkCommandBuffer CommandBuffer );
@@ -77,6 +77,13 @@ public:
    */
   VOID DeleteDrawElement( draw_element *Element );
 
+  /**
+   * \brief Replace draw element function (command buffers are rebuilt once, between frames)
+   * \param[in] OldElement Pointer to replaced element (nullptr - only add new element)
+   * \param[in] NewElement Pointer to new element (nullptr - only delete old element)
+   */
+  VOID ReplaceDrawElement( draw_element *OldElement, draw_element *NewElement );
+
   /**
    * \brief Update WVP matrix
    * \param[in] World World matrix
@@ -107,6 +114,15 @@ public:
   /** Camera object */
   camera Camera;
 
+  /** Camera position applied to draw elements (changed with render mutex locked) */
+  glm::vec3 CameraPosition = Camera.Loc;
+
+  /** Maximal distance from camera to render origin along every axis (in blocks) */
+  static constexpr FLT MaxOriginDistance = 1024;
+
+  /** World position of render origin, geometry is drawn relative to it (changed with render mutex locked) */
+  glm::ivec3 RenderOrigin = glm::ivec3(0);
+
   /** Render pass */
   render_pass RenderPass;
 
@@ -129,6 +145,14 @@ public:
   vulkan_application &VkApp;
 
 private:
+  /** Number of descriptors in default descriptor set (texture atlas, uniform buffer and packed faces) */
+  static constexpr UINT32 NumberOfDescriptors = ENABLE_VERTEX_PULLING ? 3 : 2;
+
+  /**
+   * \brief Fill texture table in uniform buffer function
+   */
+  VOID FillTextureTable( VOID );
+
   /**
    * \brief Create depth buffer function
    */
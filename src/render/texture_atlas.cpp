@@ -321,34 +321,65 @@ texture_atlas::texture_atlas( const vulkan_application &VkApp,
  */
 VOID texture_atlas::FillBlockTypesTexCoords( VOID ) const
 {
-  FillTexCoords(BLOCK_TYPE::Table[BLOCK_TYPE::StoneId].TexCoordRight, "stone.bmp");
-  FillTexCoords(BLOCK_TYPE::Table[BLOCK_TYPE::StoneId].TexCoordLeft, "stone.bmp");
-  FillTexCoords(BLOCK_TYPE::Table[BLOCK_TYPE::StoneId].TexCoordUp, "stone.bmp");
-  FillTexCoords(BLOCK_TYPE::Table[BLOCK_TYPE::StoneId].TexCoordDown, "stone.bmp");
-  FillTexCoords(BLOCK_TYPE::Table[BLOCK_TYPE::StoneId].TexCoordFront, "stone.bmp");
-  FillTexCoords(BLOCK_TYPE::Table[BLOCK_TYPE::StoneId].TexCoordBack, "stone.bmp");
-
-  FillTexCoords(BLOCK_TYPE::Table[BLOCK_TYPE::GrassId].TexCoordRight, "grass_side.bmp");
-  FillTexCoords(BLOCK_TYPE::Table[BLOCK_TYPE::GrassId].TexCoordLeft, "grass_side.bmp");
-  FillTexCoords(BLOCK_TYPE::Table[BLOCK_TYPE::GrassId].TexCoordUp, "grass_up.bmp");
-  FillTexCoords(BLOCK_TYPE::Table[BLOCK_TYPE::GrassId].TexCoordDown, "grass_down.bmp");
-  FillTexCoords(BLOCK_TYPE::Table[BLOCK_TYPE::GrassId].TexCoordFront, "grass_side.bmp");
-  FillTexCoords(BLOCK_TYPE::Table[BLOCK_TYPE::GrassId].TexCoordBack, "grass_side.bmp");
-
-  FillTexCoords(BLOCK_TYPE::Table[BLOCK_TYPE::GlassId].TexCoordRight, "glass.png");
-  FillTexCoords(BLOCK_TYPE::Table[BLOCK_TYPE::GlassId].TexCoordLeft, "glass.png");
-  FillTexCoords(BLOCK_TYPE::Table[BLOCK_TYPE::GlassId].TexCoordUp, "glass.png");
-  FillTexCoords(BLOCK_TYPE::Table[BLOCK_TYPE::GlassId].TexCoordDown, "glass.png");
-  FillTexCoords(BLOCK_TYPE::Table[BLOCK_TYPE::GlassId].TexCoordFront, "glass.png");
-  FillTexCoords(BLOCK_TYPE::Table[BLOCK_TYPE::GlassId].TexCoordBack, "glass.png");
+  std::map<std::string, UINT32> TextureIndices;
+
+  BLOCK_TYPE::TexCoords.clear();
+  BLOCK_TYPE::TexRects.clear();
+
+  BLOCK_TYPE::Table[BLOCK_TYPE::StoneId].Textures[BLOCK_TYPE::SideRight] = GetTextureIndex("stone.bmp", TextureIndices);
+  BLOCK_TYPE::Table[BLOCK_TYPE::StoneId].Textures[BLOCK_TYPE::SideLeft] = GetTextureIndex("stone.bmp", TextureIndices);
+  BLOCK_TYPE::Table[BLOCK_TYPE::StoneId].Textures[BLOCK_TYPE::SideUp] = GetTextureIndex("stone.bmp", TextureIndices);
+  BLOCK_TYPE::Table[BLOCK_TYPE::StoneId].Textures[BLOCK_TYPE::SideDown] = GetTextureIndex("stone.bmp", TextureIndices);
+  BLOCK_TYPE::Table[BLOCK_TYPE::StoneId].Textures[BLOCK_TYPE::SideFront] = GetTextureIndex("stone.bmp", TextureIndices);
+  BLOCK_TYPE::Table[BLOCK_TYPE::StoneId].Textures[BLOCK_TYPE::SideBack] = GetTextureIndex("stone.bmp", TextureIndices);
+
+  BLOCK_TYPE::Table[BLOCK_TYPE::GrassId].Textures[BLOCK_TYPE::SideRight] = GetTextureIndex("grass_side.bmp", TextureIndices);
+  BLOCK_TYPE::Table[BLOCK_TYPE::GrassId].Textures[BLOCK_TYPE::SideLeft] = GetTextureIndex("grass_side.bmp", TextureIndices);
+  BLOCK_TYPE::Table[BLOCK_TYPE::GrassId].Textures[BLOCK_TYPE::SideUp] = GetTextureIndex("grass_up.bmp", TextureIndices);
+  BLOCK_TYPE::Table[BLOCK_TYPE::GrassId].Textures[BLOCK_TYPE::SideDown] = GetTextureIndex("grass_down.bmp", TextureIndices);
+  BLOCK_TYPE::Table[BLOCK_TYPE::GrassId].Textures[BLOCK_TYPE::SideFront] = GetTextureIndex("grass_side.bmp", TextureIndices);
+  BLOCK_TYPE::Table[BLOCK_TYPE::GrassId].Textures[BLOCK_TYPE::SideBack] = GetTextureIndex("grass_side.bmp", TextureIndices);
+
+  BLOCK_TYPE::Table[BLOCK_TYPE::GlassId].Textures[BLOCK_TYPE::SideRight] = GetTextureIndex("glass.png", TextureIndices);
+  BLOCK_TYPE::Table[BLOCK_TYPE::GlassId].Textures[BLOCK_TYPE::SideLeft] = GetTextureIndex("glass.png", TextureIndices);
+  BLOCK_TYPE::Table[BLOCK_TYPE::GlassId].Textures[BLOCK_TYPE::SideUp] = GetTextureIndex("glass.png", TextureIndices);
+  BLOCK_TYPE::Table[BLOCK_TYPE::GlassId].Textures[BLOCK_TYPE::SideDown] = GetTextureIndex("glass.png", TextureIndices);
+  BLOCK_TYPE::Table[BLOCK_TYPE::GlassId].Textures[BLOCK_TYPE::SideFront] = GetTextureIndex("glass.png", TextureIndices);
+  BLOCK_TYPE::Table[BLOCK_TYPE::GlassId].Textures[BLOCK_TYPE::SideBack] = GetTextureIndex("glass.png", TextureIndices);
+
+  BLOCK_TYPE::BuildFaceTextures();
+}
+
+/**
+ * \brief Get texture index (texture coordinates are added to block types on first request)
+ * \param[in] TexName Name of texture
+ * \param[in, out] TextureIndices Map with already added textures indices
+ * \return Texture index
+ */
+UINT32 texture_atlas::GetTextureIndex( const std::string &TexName, std::map<std::string, UINT32> &TextureIndices ) const
+{
+  std::map<std::string, UINT32>::const_iterator It = TextureIndices.find(TexName);
+
+  if (It != TextureIndices.cend())
+    return It->second;
+
+  UINT32 Index = BLOCK_TYPE::TexCoords.size();
+
+  BLOCK_TYPE::TexCoords.emplace_back();
+  BLOCK_TYPE::TexRects.emplace_back();
+  FillTexCoords(BLOCK_TYPE::TexCoords[Index].data(), BLOCK_TYPE::TexRects[Index], TexName);
+  TextureIndices[TexName] = Index;
+
+  return Index;
 }
 
 /**
  * \brief Fill texture coordinates
- * \param[in, out] TexCoords Pointer to texture
+ * \param[in, out] TexCoords Pointer to texture coordinates in tile
+ * \param[in, out] TexRect Texture tile rectangle in atlas
  * \param[in] TexName Name of texture
  */
-VOID texture_atlas::FillTexCoords( glm::vec2 *TexCoords, const std::string &TexName ) const
+VOID texture_atlas::FillTexCoords( glm::vec2 *TexCoords, glm::vec4 &TexRect, const std::string &TexName ) const
 {
   std::map<std::string, IMAGE_DESCRIPTION>::const_iterator It = ImageDescriptions.find(TexName);
 
@@ -361,10 +392,13 @@ VOID texture_atlas::FillTexCoords( glm::vec2 *TexCoords, const std::string &TexN
   FLT SizeX = Description.W / (FLT)Width;
   FLT SizeY = Description.H / (FLT)Height;
 
-  TexCoords[0] = Offset + glm::vec2(SizeX, SizeY);;
-  TexCoords[1] = Offset + glm::vec2(SizeX, 0);
-  TexCoords[2] = Offset + glm::vec2(0, 0);
-  TexCoords[3] = Offset + glm::vec2(0, SizeY);
+  /* Shader repeats tile, so merged faces use coordinates greater than 1 */
+  TexRect = glm::vec4(Offset.x, Offset.y, SizeX, SizeY);
+
+  TexCoords[0] = glm::vec2(1, 1);
+  TexCoords[1] = glm::vec2(1, 0);
+  TexCoords[2] = glm::vec2(0, 0);
+  TexCoords[3] = glm::vec2(0, 1);
 }
 
 /**
@@ -50,10 +50,19 @@ private:
 
   /**
    * \brief Fill texture coordinates
-   * \param[in, out] TexCoords Pointer to texture
+   * \param[in, out] TexCoords Pointer to texture coordinates in tile
+   * \param[in, out] TexRect Texture tile rectangle in atlas
    * \param[in] TexName Name of texture
    */
-  VOID FillTexCoords( glm::vec2 *TexCoords, const std::string &TexName ) const;
+  VOID FillTexCoords( glm::vec2 *TexCoords, glm::vec4 &TexRect, const std::string &TexName ) const;
+
+  /**
+   * \brief Get texture index (texture coordinates are added to block types on first request)
+   * \param[in] TexName Name of texture
+   * \param[in, out] TextureIndices Map with already added textures indices
+   * \return Texture index
+   */
+  UINT32 GetTextureIndex( const std::string &TexName, std::map<std::string, UINT32> &TextureIndices ) const;
 
   /** Reference to vulkan application */
   const vulkan_application &VkApp;
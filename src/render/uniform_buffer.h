@@ -9,11 +9,20 @@
 struct uniform_buffer
 {
 public:
+  /** Maximal number of textures in texture table */
+  static constexpr UINT32 MaxNumberOfTextures = 32;
+
   /** World view projection matrix */
   glm::mat4 MatrWVP;
 
+  /** Texture tile rectangles in atlas for every texture index */
+  glm::vec4 TexRects[MaxNumberOfTextures];
+
+  /** Alpha for every texture index (4 textures in vector, used by packed faces) */
+  glm::vec4 TexAlphas[MaxNumberOfTextures / 4];
+
   /** Newer used padding */
-  BYTE _Padding[256 - sizeof(glm::mat4)];
+  BYTE _Padding[1024 - sizeof(glm::mat4) - sizeof(glm::vec4) * (MaxNumberOfTextures + MaxNumberOfTextures / 4)];
 
 private:
   /**
@@ -21,7 +30,7 @@ private:
    */
   static VOID PaddingTest( VOID )
   {
-    static_assert(sizeof(uniform_buffer) == 256);
+    static_assert(sizeof(uniform_buffer) == 1024);
   }
 };
 
@@ -6,14 +6,39 @@
  */
 struct VERTEX
 {
-  /** Vertex position */
-  glm::vec3 Position;
+  /** Packed vertex position in chunk (see PackPosition), chunk origin is taken from push constants */
+  UINT32 Position;
 
   /** Vertex alpha channel */
   FLT Alpha;
 
-  /** Texture coordinates */
+  /** Texture coordinates (in texture tiles, repeated in shader) */
   glm::vec2 TexCoord;
+
+  /** Texture index (tile rectangle in atlas is taken from uniform buffer texture table) */
+  UINT32 Texture;
+
+  /**
+   * \brief Pack vertex position in chunk function
+   *
+   * Bits: 0-7 - x, 8-23 - y, 24-31 - z (vertices of 16x256x16 chunk are in 0..16, 0..256 and 0..16).
+   * \param[in] Pos Vertex position in chunk
+   * \return Packed position
+   */
+  static UINT32 PackPosition( const glm::ivec3 &Pos )
+  {
+    return (UINT32)Pos.x | ((UINT32)Pos.y << 8) | ((UINT32)Pos.z << 24);
+  }
+
+  /**
+   * \brief Unpack vertex position in chunk function
+   * \param[in] Position Packed position
+   * \return Vertex position in chunk
+   */
+  static glm::ivec3 UnpackPosition( UINT32 Position )
+  {
+    return glm::ivec3(Position & 0xFF, (Position >> 8) & 0xFFFF, Position >> 24);
+  }
 };
 
 #endif /* __vertex_h_ */
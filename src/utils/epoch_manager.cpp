@@ -0,0 +1,108 @@
+#include <thread>
+#include <algorithm>
+#include <iterator>
+
+#include "epoch_manager.h"
+
+/**
+ * \brief Enter epoch function (reader side)
+ * \return Reader slot index
+ */
+UINT32 epoch_manager::Enter( VOID )
+{
+  UINT32 Start = std::hash<std::thread::id>()(std::this_thread::get_id()) % MaxReaders;
+
+  while (TRUE)
+  {
+    for (UINT32 i = 0; i < MaxReaders; i++)
+    {
+      UINT32 ReaderId = (Start + i) % MaxReaders;
+      UINT64 FreeEpoch = 0;
+
+      /* Pointer loads after this (sequentially consistent) store can't see objects retired before */
+      if (Readers[ReaderId].Epoch.compare_exchange_strong(FreeEpoch, GlobalEpoch.load()))
+        return ReaderId;
+    }
+
+    std::this_thread::yield();
+  }
+}
+
+/**
+ * \brief Leave epoch function (reader side)
+ * \param[in] ReaderId Reader slot index
+ */
+VOID epoch_manager::Leave( UINT32 ReaderId )
+{
+  Readers[ReaderId].Epoch.store(0);
+}
+
+/**
+ * \brief Retire unpublished object function (writer side)
+ * \param[in] Deleter Object deletion function
+ */
+VOID epoch_manager::Retire( std::function<VOID( VOID )> Deleter )
+{
+  {
+    std::lock_guard<std::mutex> Lock(RetiredMutex);
+
+    Retired.push_back({GlobalEpoch.fetch_add(1), std::move(Deleter)});
+  }
+
+  Collect();
+}
+
+/**
+ * \brief Delete retired objects which aren't visible for readers function (writer side)
+ */
+VOID epoch_manager::Collect( VOID )
+{
+  UINT64 MinEpoch = UINT64_MAX;
+
+  for (READER_SLOT &Reader : Readers)
+  {
+    UINT64 Epoch = Reader.Epoch.load();
+
+    if (Epoch != 0)
+      MinEpoch = std::min(MinEpoch, Epoch);
+  }
+
+  std::vector<RETIRED> Free;
+
+  {
+    std::lock_guard<std::mutex> Lock(RetiredMutex);
+
+    /* Object retired in epoch E may be seen only by readers entered in epoch <= E */
+    std::vector<RETIRED>::iterator It = std::partition(Retired.begin(), Retired.end(),
+      [MinEpoch]( const RETIRED &Object )
+      {
+        return Object.Epoch >= MinEpoch;
+      });
+
+    std::move(It, Retired.end(), std::back_inserter(Free));
+    Retired.erase(It, Retired.end());
+  }
+
+  for (RETIRED &Object : Free)
+    Object.Deleter();
+}
+
+/**
+ * \brief Get number of not deleted retired objects function
+ * \return Number of retired objects
+ */
+UINT64 epoch_manager::GetNumberOfRetired( VOID )
+{
+  std::lock_guard<std::mutex> Lock(RetiredMutex);
+
+  return Retired.size();
+}
+
+/**
+ * \brief Epoch manager destructor (deletes all retired objects)
+ */
+epoch_manager::~epoch_manager( VOID )
+{
+  for (RETIRED &Object : Retired)
+    Object.Deleter();
+}
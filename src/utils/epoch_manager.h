@@ -0,0 +1,127 @@
+#ifndef __epoch_manager_h_
+#define __epoch_manager_h_
+
+#include <atomic>
+#include <array>
+#include <vector>
+#include <functional>
+#include <mutex>
+
+#include "def.h"
+
+/**
+ * \brief Epoch based memory reclamation class
+ *
+ * Readers enter epoch before loading published pointers and leave it after last access.
+ * Writer unpublishes object (stores new pointer) and retires old one - it is deleted
+ * only after all readers which could see it left their epochs.
+ */
+class epoch_manager
+{
+public:
+  /** Maximal number of simultaneous readers */
+  static constexpr UINT32 MaxReaders = 64;
+
+  /**
+   * \brief Reader epoch guard class
+   */
+  class guard
+  {
+  public:
+    /**
+     * \brief Guard constructor (enters epoch)
+     * \param[in, out] Manager Epoch manager
+     */
+    guard( epoch_manager &Manager ) : Manager(Manager), ReaderId(Manager.Enter())
+    {
+    }
+
+    guard( const guard & ) = delete;
+    guard & operator=( const guard & ) = delete;
+
+    /**
+     * \brief Guard destructor (leaves epoch)
+     */
+    ~guard( VOID )
+    {
+      Manager.Leave(ReaderId);
+    }
+
+  private:
+    /** Epoch manager */
+    epoch_manager &Manager;
+
+    /** Reader slot index */
+    UINT32 ReaderId;
+  };
+
+  /**
+   * \brief Enter epoch function (reader side)
+   * \return Reader slot index
+   */
+  UINT32 Enter( VOID );
+
+  /**
+   * \brief Leave epoch function (reader side)
+   * \param[in] ReaderId Reader slot index
+   */
+  VOID Leave( UINT32 ReaderId );
+
+  /**
+   * \brief Retire unpublished object function (writer side)
+   * \param[in] Deleter Object deletion function
+   */
+  VOID Retire( std::function<VOID( VOID )> Deleter );
+
+  /**
+   * \brief Delete retired objects which aren't visible for readers function (writer side)
+   */
+  VOID Collect( VOID );
+
+  /**
+   * \brief Get number of not deleted retired objects function
+   * \return Number of retired objects
+   */
+  UINT64 GetNumberOfRetired( VOID );
+
+  /**
+   * \brief Epoch manager destructor (deletes all retired objects)
+   */
+  ~epoch_manager( VOID );
+
+private:
+  /**
+   * \brief Reader slot (on separate cache line)
+   */
+  struct alignas(64) READER_SLOT
+  {
+    /** Epoch reader entered in (0-if slot is free) */
+    std::atomic<UINT64> Epoch = 0;
+  };
+
+  /**
+   * \brief Retired object
+   */
+  struct RETIRED
+  {
+    /** Epoch object was retired in */
+    UINT64 Epoch;
+
+    /** Object deletion function */
+    std::function<VOID( VOID )> Deleter;
+  };
+
+  /** Global epoch */
+  std::atomic<UINT64> GlobalEpoch = 1;
+
+  /** Reader slots */
+  std::array<READER_SLOT, MaxReaders> Readers;
+
+  /** Mutex for retired objects list */
+  std::mutex RetiredMutex;
+
+  /** Retired objects */
+  std::vector<RETIRED> Retired;
+};
+
+#endif /* __epoch_manager_h_ */
@@ -0,0 +1,292 @@
+#include <algorithm>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+#include "range_allocator.h"
+
+/**
+ * \brief Get index of lowest set bit function
+ * \param[in] Bits Not zero word
+ * \return Bit index
+ */
+static UINT32 GetLowestBit( UINT64 Bits )
+{
+#ifdef _MSC_VER
+  unsigned long Index;
+
+  _BitScanForward64(&Index, Bits);
+  return Index;
+#else
+  return __builtin_ctzll(Bits);
+#endif
+}
+
+/**
+ * \brief Get index of highest set bit function
+ * \param[in] Bits Not zero word
+ * \return Bit index
+ */
+static UINT32 GetHighestBit( UINT64 Bits )
+{
+#ifdef _MSC_VER
+  unsigned long Index;
+
+  _BitScanReverse64(&Index, Bits);
+  return Index;
+#else
+  return 63 - __builtin_clzll(Bits);
+#endif
+}
+
+/**
+ * \brief Range allocator constructor
+ * \param[in] Capacity Space size (in allocation units)
+ */
+range_allocator::range_allocator( UINT64 Capacity ) : Capacity(Capacity)
+{
+  for (std::array<UINT32, SecondLevelCount> &Lists : FreeLists)
+    Lists.fill(None);
+
+  if (Capacity == 0)
+    return;
+
+  UINT32 RangeId = CreateRange();
+
+  Ranges[RangeId].Size = Capacity;
+  InsertFree(RangeId);
+}
+
+/**
+ * \brief Get size class of range function
+ * \param[in] Size Range size
+ * \param[out] FirstLevel First level index
+ * \param[out] SecondLevel Second level index
+ */
+VOID range_allocator::GetClass( UINT64 Size, UINT32 &FirstLevel, UINT32 &SecondLevel )
+{
+  /* Small sizes are spread linearly in first class */
+  if (Size < SecondLevelCount)
+  {
+    FirstLevel = 0;
+    SecondLevel = Size;
+    return;
+  }
+
+  UINT32 HighestBit = GetHighestBit(Size);
+
+  FirstLevel = HighestBit - SecondLevelLog + 1;
+  SecondLevel = (Size >> (HighestBit - SecondLevelLog)) - SecondLevelCount;
+}
+
+/**
+ * \brief Create range description function (reuses released descriptions)
+ * \return Range index
+ */
+UINT32 range_allocator::CreateRange( VOID )
+{
+  if (UnusedRanges.empty())
+  {
+    Ranges.emplace_back();
+    return Ranges.size() - 1;
+  }
+
+  UINT32 RangeId = UnusedRanges.back();
+
+  UnusedRanges.pop_back();
+  Ranges[RangeId] = RANGE();
+
+  return RangeId;
+}
+
+/**
+ * \brief Insert range to its free list function
+ * \param[in] RangeId Range index
+ */
+VOID range_allocator::InsertFree( UINT32 RangeId )
+{
+  RANGE &Range = Ranges[RangeId];
+  UINT32 FirstLevel, SecondLevel;
+
+  GetClass(Range.Size, FirstLevel, SecondLevel);
+
+  UINT32 &Head = FreeLists[FirstLevel][SecondLevel];
+
+  Range.IsFree = TRUE;
+  Range.PrevFree = None;
+  Range.NextFree = Head;
+
+  if (Head != None)
+    Ranges[Head].PrevFree = RangeId;
+
+  Head = RangeId;
+  FirstLevelBits |= 1ull << FirstLevel;
+  SecondLevelBits[FirstLevel] |= 1u << SecondLevel;
+}
+
+/**
+ * \brief Remove range from its free list function
+ * \param[in] RangeId Range index
+ */
+VOID range_allocator::RemoveFree( UINT32 RangeId )
+{
+  RANGE &Range = Ranges[RangeId];
+  UINT32 FirstLevel, SecondLevel;
+
+  GetClass(Range.Size, FirstLevel, SecondLevel);
+
+  if (Range.PrevFree != None)
+    Ranges[Range.PrevFree].NextFree = Range.NextFree;
+  else
+    FreeLists[FirstLevel][SecondLevel] = Range.NextFree;
+
+  if (Range.NextFree != None)
+    Ranges[Range.NextFree].PrevFree = Range.PrevFree;
+
+  Range.IsFree = FALSE;
+
+  if (FreeLists[FirstLevel][SecondLevel] == None)
+  {
+    SecondLevelBits[FirstLevel] &= ~(1u << SecondLevel);
+
+    if (SecondLevelBits[FirstLevel] == 0)
+      FirstLevelBits &= ~(1ull << FirstLevel);
+  }
+}
+
+/**
+ * \brief Merge next physical range into range function (both ranges are out of free lists)
+ * \param[in] RangeId Range index
+ */
+VOID range_allocator::MergeNext( UINT32 RangeId )
+{
+  RANGE &Range = Ranges[RangeId];
+  UINT32 NextId = Range.NextPhysical;
+  RANGE &Next = Ranges[NextId];
+
+  Range.Size += Next.Size;
+  Range.NextPhysical = Next.NextPhysical;
+
+  if (Next.NextPhysical != None)
+    Ranges[Next.NextPhysical].PrevPhysical = RangeId;
+
+  UnusedRanges.push_back(NextId);
+}
+
+/**
+ * \brief Allocate range function
+ * \param[in] Size Range size (not zero)
+ * \return Range index or std::nullopt if there is no free range of such size
+ */
+std::optional<UINT32> range_allocator::Allocate( UINT64 Size )
+{
+  if (Size == 0 || Size > Capacity)
+    return std::nullopt;
+
+  /* Size is rounded up to next class, so any range of found class fits without list search */
+  UINT64 ClassSize = Size;
+
+  if (Size >= SecondLevelCount)
+    ClassSize += (1ull << (GetHighestBit(Size) - SecondLevelLog)) - 1;
+
+  UINT32 FirstLevel, SecondLevel;
+
+  GetClass(ClassSize, FirstLevel, SecondLevel);
+
+  UINT32 SecondBits = SecondLevelBits[FirstLevel] & (~0u << SecondLevel);
+
+  /* Smallest not empty class of greater first level */
+  if (SecondBits == 0)
+  {
+    UINT64 FirstBits = FirstLevelBits & (~0ull << (FirstLevel + 1));
+
+    if (FirstBits == 0)
+      return std::nullopt;
+
+    FirstLevel = GetLowestBit(FirstBits);
+    SecondBits = SecondLevelBits[FirstLevel];
+  }
+
+  SecondLevel = GetLowestBit(SecondBits);
+
+  UINT32 RangeId = FreeLists[FirstLevel][SecondLevel];
+
+  RemoveFree(RangeId);
+
+  /* Rest of range is returned to free lists */
+  if (Ranges[RangeId].Size > Size)
+  {
+    UINT32 RestId = CreateRange();
+    RANGE &Range = Ranges[RangeId];
+    RANGE &Rest = Ranges[RestId];
+
+    Rest.Offset = Range.Offset + Size;
+    Rest.Size = Range.Size - Size;
+    Rest.PrevPhysical = RangeId;
+    Rest.NextPhysical = Range.NextPhysical;
+
+    if (Range.NextPhysical != None)
+      Ranges[Range.NextPhysical].PrevPhysical = RestId;
+
+    Range.NextPhysical = RestId;
+    Range.Size = Size;
+    InsertFree(RestId);
+  }
+
+  AllocatedSize += Size;
+  NumberOfAllocations++;
+
+  return RangeId;
+}
+
+/**
+ * \brief Free range function
+ * \param[in] RangeId Range index
+ */
+VOID range_allocator::Free( UINT32 RangeId )
+{
+  AllocatedSize -= Ranges[RangeId].Size;
+  NumberOfAllocations--;
+
+  UINT32 NextId = Ranges[RangeId].NextPhysical;
+
+  if (NextId != None && Ranges[NextId].IsFree)
+  {
+    RemoveFree(NextId);
+    MergeNext(RangeId);
+  }
+
+  UINT32 PrevId = Ranges[RangeId].PrevPhysical;
+
+  if (PrevId != None && Ranges[PrevId].IsFree)
+  {
+    RemoveFree(PrevId);
+    MergeNext(PrevId);
+    RangeId = PrevId;
+  }
+
+  InsertFree(RangeId);
+}
+
+/**
+ * \brief Get allocator statistics function (walks free lists)
+ * \return Statistics
+ */
+range_allocator::STATS range_allocator::GetStats( VOID ) const
+{
+  STATS Stats;
+
+  Stats.Capacity = Capacity;
+  Stats.AllocatedSize = AllocatedSize;
+  Stats.NumberOfAllocations = NumberOfAllocations;
+
+  for (const std::array<UINT32, SecondLevelCount> &Lists : FreeLists)
+    for (UINT32 RangeId : Lists)
+      for (; RangeId != None; RangeId = Ranges[RangeId].NextFree)
+      {
+        Stats.NumberOfFreeRanges++;
+        Stats.LargestFreeRange = std::max(Stats.LargestFreeRange, Ranges[RangeId].Size);
+      }
+
+  return Stats;
+}
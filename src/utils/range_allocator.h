@@ -0,0 +1,187 @@
+#ifndef __range_allocator_h_
+#define __range_allocator_h_
+
+#include <array>
+#include <vector>
+#include <optional>
+
+#include "def.h"
+
+/**
+ * \brief Two-level segregated fit (TLSF) allocator of ranges class
+ *
+ * Allocates exactly sized ranges in linear space (GPU buffer) in constant time. Free ranges are kept in
+ * lists by size class: first level is power of 2, second level splits it into SecondLevelCount parts.
+ * Bookkeeping is stored outside of allocated space, adjacent free ranges are merged on free.
+ * Class isn't thread-safe.
+ */
+class range_allocator
+{
+public:
+  /**
+   * \brief Allocator statistics structure
+   */
+  struct STATS
+  {
+    /** Space size */
+    UINT64 Capacity = 0;
+
+    /** Size of allocated ranges */
+    UINT64 AllocatedSize = 0;
+
+    /** Number of allocated ranges */
+    UINT64 NumberOfAllocations = 0;
+
+    /** Number of free ranges */
+    UINT64 NumberOfFreeRanges = 0;
+
+    /** Size of largest free range */
+    UINT64 LargestFreeRange = 0;
+
+    /**
+     * \brief Get fragmentation function
+     * \return Part of free space which isn't in largest free range (0 - free space is one range)
+     */
+    DBL GetFragmentation( VOID ) const
+    {
+      UINT64 FreeSize = Capacity - AllocatedSize;
+
+      return FreeSize == 0 ? 0 : 1 - (DBL)LargestFreeRange / FreeSize;
+    }
+  };
+
+  /**
+   * \brief Range allocator constructor
+   * \param[in] Capacity Space size (in allocation units)
+   */
+  range_allocator( UINT64 Capacity );
+
+  /**
+   * \brief Allocate range function
+   * \param[in] Size Range size (not zero)
+   * \return Range index or std::nullopt if there is no free range of such size
+   */
+  std::optional<UINT32> Allocate( UINT64 Size );
+
+  /**
+   * \brief Free range function
+   * \param[in] RangeId Range index
+   */
+  VOID Free( UINT32 RangeId );
+
+  /**
+   * \brief Get range offset function
+   * \param[in] RangeId Range index
+   * \return Offset in space
+   */
+  UINT64 GetOffset( UINT32 RangeId ) const
+  {
+    return Ranges[RangeId].Offset;
+  }
+
+  /**
+   * \brief Get range size function
+   * \param[in] RangeId Range index
+   * \return Range size
+   */
+  UINT64 GetSize( UINT32 RangeId ) const
+  {
+    return Ranges[RangeId].Size;
+  }
+
+  /**
+   * \brief Get allocator statistics function (walks free lists)
+   * \return Statistics
+   */
+  STATS GetStats( VOID ) const;
+
+private:
+  /** Number of second level lists in every first level (power of 2) */
+  static constexpr UINT32 SecondLevelLog = 4;
+  static constexpr UINT32 SecondLevelCount = 1 << SecondLevelLog;
+
+  /** Number of first level classes (sizes less than SecondLevelCount are in first class) */
+  static constexpr UINT32 FirstLevelCount = 64 - SecondLevelLog + 1;
+
+  /** No range index */
+  static constexpr UINT32 None = ~0u;
+
+  /**
+   * \brief Range description structure
+   */
+  struct RANGE
+  {
+    /** Offset in space */
+    UINT64 Offset = 0;
+
+    /** Range size */
+    UINT64 Size = 0;
+
+    /** Previous and next ranges in space */
+    UINT32 PrevPhysical = None, NextPhysical = None;
+
+    /** Previous and next ranges in free list */
+    UINT32 PrevFree = None, NextFree = None;
+
+    /** Range is free flag */
+    BOOL IsFree = FALSE;
+  };
+
+  /**
+   * \brief Get size class of range function
+   * \param[in] Size Range size
+   * \param[out] FirstLevel First level index
+   * \param[out] SecondLevel Second level index
+   */
+  static VOID GetClass( UINT64 Size, UINT32 &FirstLevel, UINT32 &SecondLevel );
+
+  /**
+   * \brief Create range description function (reuses released descriptions)
+   * \return Range index
+   */
+  UINT32 CreateRange( VOID );
+
+  /**
+   * \brief Insert range to its free list function
+   * \param[in] RangeId Range index
+   */
+  VOID InsertFree( UINT32 RangeId );
+
+  /**
+   * \brief Remove range from its free list function
+   * \param[in] RangeId Range index
+   */
+  VOID RemoveFree( UINT32 RangeId );
+
+  /**
+   * \brief Merge next physical range into range function (both ranges are out of free lists)
+   * \param[in] RangeId Range index
+   */
+  VOID MergeNext( UINT32 RangeId );
+
+  /** Range descriptions */
+  std::vector<RANGE> Ranges;
+
+  /** Released range descriptions */
+  std::vector<UINT32> UnusedRanges;
+
+  /** Heads of free lists */
+  std::array<std::array<UINT32, SecondLevelCount>, FirstLevelCount> FreeLists;
+
+  /** Bit i is set if first level i has not empty second level list */
+  UINT64 FirstLevelBits = 0;
+
+  /** Bit j of element i is set if free list (i, j) isn't empty */
+  std::array<UINT32, FirstLevelCount> SecondLevelBits = {};
+
+  /** Space size */
+  UINT64 Capacity;
+
+  /** Size of allocated ranges */
+  UINT64 AllocatedSize = 0;
+
+  /** Number of allocated ranges */
+  UINT64 NumberOfAllocations = 0;
+};
+
+#endif /* __range_allocator_h_ */
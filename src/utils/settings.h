@@ -1,6 +1,8 @@
 #ifndef __settings_h_
 #define __settings_h_
 
+#include <array>
+
 #include "def.h"
 
 /**
@@ -23,6 +25,15 @@ public:
 
   /** Enable Vulkan fullscreen surface extension flag */
   BOOL EnableVulkanFullscreenSurfaceExtension = FALSE;
+
+  /** Number of chunk meshing threads (0 - number of hardware threads without one) */
+  UINT32 NumberOfMeshingThreads = 0;
+
+  /** Distances in chunks beyond which chunks are meshed from 2x and 4x downsampled blocks */
+  std::array<INT, 2> LodDistances = {4, 8};
+
+  /** Average number of borders reserved per chunk in shared vertex memory (large meshes use space of small ones) */
+  UINT32 AverageChunkBorders = 2048;
 };
 
 #endif /* __settings_h_ */
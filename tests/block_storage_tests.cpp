@@ -0,0 +1,211 @@
+#include <vector>
+#include <stdexcept>
+#include <cstring>
+
+#include <boost/test/unit_test.hpp>
+
+#include "game_objects/block_storage.h"
+#include "game_objects/block_type.h"
+
+/** Number of blocks in tested storages (one chunk section) */
+static constexpr UINT32 NumberOfBlocks = 16 * 16 * 16;
+
+/** Numbers of distinct block states for every bits per block case (palette fits exactly and overflows by one) */
+static const UINT32 NumbersOfStates[] = {1, 2, 3, 4, 5, 16, 17, 256, 257, 1000};
+
+/**
+ * \brief Block types table with enough types for 16-bit palettes fixture structure
+ */
+struct BLOCK_TYPES_FIXTURE
+{
+  /** Original block types table */
+  std::vector<BLOCK_TYPE> Types = BLOCK_TYPE::Table;
+
+  /**
+   * \brief Fixture constructor
+   */
+  BLOCK_TYPES_FIXTURE( VOID )
+  {
+    BLOCK_TYPE::Table.resize(64, BLOCK_TYPE(1));
+  }
+
+  /**
+   * \brief Fixture destructor (restores table)
+   */
+  ~BLOCK_TYPES_FIXTURE( VOID )
+  {
+    BLOCK_TYPE::Table = Types;
+  }
+};
+
+/**
+ * \brief Get distinct valid block state function
+ * \param[in] State State number
+ * \return Block state
+ */
+static BLOCK GetState( UINT32 State )
+{
+  BLOCK Block;
+
+  Block.BlockTypeId = State / BLOCK::NumberOfOrientations;
+  Block.Orientation = State % BLOCK::NumberOfOrientations;
+
+  return Block;
+}
+
+/**
+ * \brief Fill storage with states in scattered order function
+ * \param[in, out] Storage Blocks storage
+ * \param[in] NumberOfStates Number of distinct states
+ * \return Expected block states
+ */
+static std::vector<BLOCK> FillStorage( block_storage &Storage, UINT32 NumberOfStates )
+{
+  std::vector<BLOCK> Expected(NumberOfBlocks, GetState(0));
+
+  for (UINT32 i = 0; i < NumberOfBlocks; i++)
+  {
+    /* Odd multiplier visits every index once, states come in order so palette grows during fill */
+    UINT32 Index = i * 2654435761u % NumberOfBlocks;
+
+    Expected[Index] = GetState(i % NumberOfStates);
+    Storage.Set(Index, Expected[Index]);
+  }
+
+  return Expected;
+}
+
+/**
+ * \brief Get expected number of bits per block function
+ * \param[in] NumberOfStates Number of distinct states
+ * \return Number of bits per block
+ */
+static UINT32 GetExpectedBits( UINT32 NumberOfStates )
+{
+  UINT32 Bits = 1;
+
+  while ((1u << Bits) < NumberOfStates)
+    Bits *= 2;
+
+  return Bits;
+}
+
+BOOST_AUTO_TEST_SUITE(block_storage_tests)
+
+BOOST_AUTO_TEST_CASE(set_get_across_bit_widths)
+{
+  for (UINT32 NumberOfStates : NumbersOfStates)
+  {
+    block_storage Storage(NumberOfBlocks);
+    std::vector<BLOCK> Expected = FillStorage(Storage, NumberOfStates);
+
+    BOOST_TEST(Storage.GetBitsPerBlock() == GetExpectedBits(NumberOfStates));
+    BOOST_TEST(Storage.GetPaletteSize() == NumberOfStates);
+
+    for (UINT32 i = 0; i < NumberOfBlocks; i++)
+      BOOST_TEST_REQUIRE((Storage.Get(i) == Expected[i]), "block " << i << ", states " << NumberOfStates);
+
+    /* Overwrite keeps neighbour indices in same word */
+    Storage.Set(1, GetState(NumberOfStates - 1));
+    BOOST_TEST((Storage.Get(0) == Expected[0]));
+    BOOST_TEST((Storage.Get(1) == GetState(NumberOfStates - 1)));
+    BOOST_TEST((Storage.Get(2) == Expected[2]));
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE(save_load_across_bit_widths, BLOCK_TYPES_FIXTURE)
+{
+  for (UINT32 NumberOfStates : NumbersOfStates)
+  {
+    block_storage Storage(NumberOfBlocks);
+    std::vector<BLOCK> Expected = FillStorage(Storage, NumberOfStates);
+
+    /* Storage is appended after other data */
+    std::vector<BYTE> Bytes(3, 0xAB);
+
+    Storage.Save(Bytes);
+
+    UINT64 SavedSize = Bytes.size() - 3;
+    UINT32 Bits = GetExpectedBits(NumberOfStates);
+
+    BOOST_TEST(SavedSize == 3 * sizeof(UINT32) + NumberOfStates * block_storage::SavedBlockSize +
+                            (NumberOfBlocks * Bits + 63) / 64 * sizeof(UINT64));
+
+    block_storage Loaded(NumberOfBlocks);
+
+    BOOST_TEST(Loaded.Load(Bytes.data() + 3, SavedSize) == SavedSize);
+    BOOST_TEST(Loaded.GetBitsPerBlock() == Bits);
+    BOOST_TEST(Loaded.GetPaletteSize() == NumberOfStates);
+
+    for (UINT32 i = 0; i < NumberOfBlocks; i++)
+      BOOST_TEST_REQUIRE((Loaded.Get(i) == Expected[i]), "block " << i << ", states " << NumberOfStates);
+
+    /* Loaded storage keeps growing after load */
+    Loaded.Set(0, GetState(NumberOfStates));
+    BOOST_TEST((Loaded.Get(0) == GetState(NumberOfStates)));
+    BOOST_TEST((Loaded.Get(1) == Expected[1]));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(save_is_deterministic)
+{
+  /* Blocks are saved field by field, so equal storages give equal bytes */
+  block_storage First(NumberOfBlocks), Second(NumberOfBlocks);
+
+  FillStorage(First, 5);
+  FillStorage(Second, 5);
+
+  std::vector<BYTE> FirstBytes, SecondBytes;
+
+  First.Save(FirstBytes);
+  Second.Save(SecondBytes);
+
+  BOOST_TEST(FirstBytes == SecondBytes);
+}
+
+BOOST_AUTO_TEST_CASE(load_rejects_corrupted_data)
+{
+  block_storage Storage(NumberOfBlocks);
+
+  FillStorage(Storage, 3);
+
+  std::vector<BYTE> Bytes;
+
+  Storage.Save(Bytes);
+
+  /* Palette starts after header, indices after palette */
+  const UINT64 PaletteOffset = 3 * sizeof(UINT32);
+  const UINT64 DataOffset = PaletteOffset + 3 * block_storage::SavedBlockSize;
+
+  block_storage Loaded(NumberOfBlocks);
+
+  BOOST_CHECK_NO_THROW(Loaded.Load(Bytes.data(), Bytes.size()));
+  BOOST_CHECK_THROW(Loaded.Load(Bytes.data(), Bytes.size() - 1), std::runtime_error);
+
+  block_storage OtherSize(NumberOfBlocks / 2);
+
+  BOOST_CHECK_THROW(OtherSize.Load(Bytes.data(), Bytes.size()), std::runtime_error);
+
+  /* Not existing block type */
+  std::vector<BYTE> Corrupted = Bytes;
+  UINT32 TypeId = BLOCK_TYPE::Table.size();
+
+  memcpy(Corrupted.data() + PaletteOffset, &TypeId, sizeof(UINT32));
+  BOOST_CHECK_THROW(Loaded.Load(Corrupted.data(), Corrupted.size()), std::runtime_error);
+
+  /* Not existing orientation */
+  Corrupted = Bytes;
+  Corrupted[PaletteOffset + sizeof(UINT32)] = BLOCK::NumberOfOrientations;
+  BOOST_CHECK_THROW(Loaded.Load(Corrupted.data(), Corrupted.size()), std::runtime_error);
+
+  /* 2-bit index 3 is past 3-entry palette */
+  Corrupted = Bytes;
+  Corrupted[DataOffset] = 0xFF;
+  BOOST_CHECK_THROW(Loaded.Load(Corrupted.data(), Corrupted.size()), std::runtime_error);
+
+  /* Failed load keeps previous contents */
+  for (UINT32 i = 0; i < NumberOfBlocks; i++)
+    BOOST_TEST_REQUIRE((Loaded.Get(i) == Storage.Get(i)));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,299 @@
+#include <vector>
+#include <array>
+#include <random>
+#include <cstring>
+
+#include <boost/test/unit_test.hpp>
+
+#include "game_objects/chunk_blocks.h"
+#include "game_objects/block_type.h"
+#include "render/chunk_mesher.h"
+
+/** Number of textures in test texture table */
+static constexpr UINT32 NumberOfTextures = 32;
+
+/**
+ * \brief Texture table for saved quads texture indices fixture structure
+ */
+struct TEXTURE_INDICES_FIXTURE
+{
+  /** Original block types table */
+  std::vector<BLOCK_TYPE> Types = BLOCK_TYPE::Table;
+
+  /** Original texture coordinates */
+  std::vector<std::array<glm::vec2, 4>> TexCoords = BLOCK_TYPE::TexCoords;
+
+  /** Original texture rectangles */
+  std::vector<glm::vec4> TexRects = BLOCK_TYPE::TexRects;
+
+  /** Original face textures table */
+  std::vector<UINT32> FaceTextures = BLOCK_TYPE::FaceTextures;
+
+  /**
+   * \brief Fixture constructor
+   */
+  TEXTURE_INDICES_FIXTURE( VOID )
+  {
+    BLOCK_TYPE::TexCoords.resize(NumberOfTextures);
+    BLOCK_TYPE::TexRects.resize(NumberOfTextures);
+    BLOCK_TYPE::BuildFaceTextures();
+  }
+
+  /**
+   * \brief Fixture destructor (restores tables)
+   */
+  ~TEXTURE_INDICES_FIXTURE( VOID )
+  {
+    BLOCK_TYPE::Table = Types;
+    BLOCK_TYPE::TexCoords = TexCoords;
+    BLOCK_TYPE::TexRects = TexRects;
+    BLOCK_TYPE::FaceTextures = FaceTextures;
+  }
+};
+
+/**
+ * \brief Fill mesh cache with random quads function
+ * \param[out] Cache Mesh cache
+ * \param[in] Seed Random seed
+ */
+static VOID FillRandom( CHUNK_MESH_CACHE &Cache, UINT32 Seed )
+{
+  std::mt19937 Random(Seed);
+
+  Cache.BlocksHash = ((UINT64)Random() << 32) | Random();
+  Cache.Lod = Random() % chunk_mesher::NumberOfLods;
+  Cache.BordersHash = ((UINT64)Random() << 32) | Random();
+
+  for (std::vector<chunk_mesher::QUAD> &Quads : Cache.SectionQuads)
+  {
+    /* Some sections have no quads */
+    Quads.resize(Random() % 3 == 0 ? 0 : Random() % 100);
+
+    for (chunk_mesher::QUAD &Quad : Quads)
+    {
+      Quad.Origin = glm::ivec3(Random() % chunk_blocks::ChunkSizeX, Random() % chunk_blocks::ChunkSizeY,
+                               Random() % chunk_blocks::ChunkSizeZ);
+      Quad.Face = Random() % BLOCK::NumberOfFaces;
+      Quad.SizeA = Random() % 16 + 1;
+      Quad.SizeB = Random() % 16 + 1;
+      Quad.Texture = Random() % NumberOfTextures;
+      Quad.Alpha = Random() % 2 ? 1.0f : 0.5f;
+    }
+  }
+}
+
+/**
+ * \brief Check quads are equal function
+ * \param[in] First First quads array
+ * \param[in] Second Second quads array
+ * \return TRUE if arrays have same quads
+ */
+static BOOL IsEqual( const std::vector<chunk_mesher::QUAD> &First, const std::vector<chunk_mesher::QUAD> &Second )
+{
+  if (First.size() != Second.size())
+    return FALSE;
+
+  for (UINT64 i = 0; i < First.size(); i++)
+    if (First[i].Origin != Second[i].Origin || First[i].Face != Second[i].Face || First[i].SizeA != Second[i].SizeA ||
+        First[i].SizeB != Second[i].SizeB || First[i].Texture != Second[i].Texture || First[i].Alpha != Second[i].Alpha)
+      return FALSE;
+
+  return TRUE;
+}
+
+/**
+ * \brief Get hash of saved blocks function (mesh cache key)
+ * \param[in] Blocks Chunk blocks
+ * \return Hash of saved data
+ */
+static UINT64 GetBlocksHash( const chunk_blocks &Blocks )
+{
+  std::vector<BYTE> Bytes;
+
+  Blocks.Save(Bytes);
+
+  return chunk_mesher::GetHash(Bytes.data(), Bytes.size());
+}
+
+BOOST_AUTO_TEST_SUITE(chunk_mesh_cache_tests)
+
+BOOST_FIXTURE_TEST_CASE(save_load_round_trip, TEXTURE_INDICES_FIXTURE)
+{
+  for (UINT32 Seed = 0; Seed < 5; Seed++)
+  {
+    CHUNK_MESH_CACHE Cache;
+    std::vector<BYTE> Bytes;
+
+    FillRandom(Cache, Seed);
+    Cache.Save(Bytes);
+
+    CHUNK_MESH_CACHE Loaded;
+
+    BOOST_TEST_REQUIRE(Loaded.Load(Bytes.data(), Bytes.size()));
+    BOOST_TEST(Loaded.BlocksHash == Cache.BlocksHash);
+    BOOST_TEST(Loaded.Lod == Cache.Lod);
+    BOOST_TEST(Loaded.BordersHash == Cache.BordersHash);
+
+    for (UINT32 SectionId = 0; SectionId < chunk_blocks::NumberOfSections; SectionId++)
+      BOOST_TEST_REQUIRE(IsEqual(Loaded.SectionQuads[SectionId], Cache.SectionQuads[SectionId]), "section " << SectionId);
+
+    /* Loaded mesh is saved to same bytes */
+    std::vector<BYTE> LoadedBytes;
+
+    Loaded.Save(LoadedBytes);
+    BOOST_TEST(LoadedBytes == Bytes);
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE(load_rejects_corrupted_data, TEXTURE_INDICES_FIXTURE)
+{
+  CHUNK_MESH_CACHE Cache;
+  std::vector<BYTE> Bytes;
+
+  FillRandom(Cache, 10);
+  Cache.Save(Bytes);
+
+  CHUNK_MESH_CACHE Loaded;
+
+  BOOST_TEST(!Loaded.Load(Bytes.data(), 0));
+  BOOST_TEST(!Loaded.Load(Bytes.data(), Bytes.size() - 1));
+
+  /* Trailing bytes */
+  std::vector<BYTE> Corrupted = Bytes;
+
+  Corrupted.push_back(0);
+  BOOST_TEST(!Loaded.Load(Corrupted.data(), Corrupted.size()));
+
+  /* Mesh of other format version or mesher */
+  Corrupted = Bytes;
+  Corrupted[0] ^= 1;
+  BOOST_TEST(!Loaded.Load(Corrupted.data(), Corrupted.size()));
+
+  Corrupted = Bytes;
+  Corrupted[0] ^= 2;
+  BOOST_TEST(!Loaded.Load(Corrupted.data(), Corrupted.size()));
+
+  /* Number of quads past data end */
+  const UINT64 QuadsOffset = sizeof(UINT32) + sizeof(UINT64) + sizeof(UINT64) + sizeof(UINT32) + sizeof(UINT64);
+  UINT32 NumberOfQuads = 0xFFFFFFFF;
+
+  Corrupted = Bytes;
+  memcpy(Corrupted.data() + QuadsOffset, &NumberOfQuads, sizeof(UINT32));
+  BOOST_TEST(!Loaded.Load(Corrupted.data(), Corrupted.size()));
+
+  /* Quads which would index out of mesh or texture tables or overflow packed face fields */
+  const chunk_mesher::QUAD BadQuads[] =
+  {
+    {glm::ivec3(0), BLOCK::NumberOfFaces, 1, 1, 0, 1},
+    {glm::ivec3(0), 0, 1, 1, NumberOfTextures, 1},
+    {glm::ivec3(0), 0, 0, 1, 0, 1},
+    {glm::ivec3(0), 0, 1, chunk_mesher::MaxQuadSize + 1, 0, 1},
+    {glm::ivec3(-1, 0, 0), 0, 1, 1, 0, 1},
+    {glm::ivec3(0, chunk_blocks::ChunkSizeY, 0), 0, 1, 1, 0, 1},
+    {glm::ivec3(0, 0, chunk_blocks::ChunkSizeZ), 0, 1, 1, 0, 1},
+  };
+
+  for (const chunk_mesher::QUAD &Quad : BadQuads)
+  {
+    CHUNK_MESH_CACHE Bad;
+
+    Bad.SectionQuads[0].push_back(Quad);
+    Corrupted.clear();
+    Bad.Save(Corrupted);
+    BOOST_TEST(!Loaded.Load(Corrupted.data(), Corrupted.size()), "face " << Quad.Face << ", texture " << Quad.Texture);
+  }
+
+  /* Largest valid quad is loaded */
+  CHUNK_MESH_CACHE Good;
+
+  Good.SectionQuads[0].push_back({glm::ivec3(chunk_blocks::ChunkSizeX - 1, chunk_blocks::ChunkSizeY - 1,
+                                             chunk_blocks::ChunkSizeZ - 1), BLOCK::NumberOfFaces - 1,
+                                  chunk_mesher::MaxQuadSize, chunk_mesher::MaxQuadSize, NumberOfTextures - 1, 0.5f});
+  Corrupted.clear();
+  Good.Save(Corrupted);
+  BOOST_TEST(Loaded.Load(Corrupted.data(), Corrupted.size()));
+}
+
+BOOST_FIXTURE_TEST_CASE(load_rejects_other_block_types, TEXTURE_INDICES_FIXTURE)
+{
+  CHUNK_MESH_CACHE Cache, Loaded;
+  std::vector<BYTE> Bytes;
+
+  FillRandom(Cache, 20);
+  Cache.Save(Bytes);
+  BOOST_TEST_REQUIRE(Loaded.Load(Bytes.data(), Bytes.size()));
+
+  /* Texture added to atlas */
+  BLOCK_TYPE::TexRects.emplace_back();
+  BOOST_TEST(!Loaded.Load(Bytes.data(), Bytes.size()));
+  BLOCK_TYPE::TexRects.pop_back();
+
+  /* Block type side gets other texture */
+  BLOCK_TYPE::Table[BLOCK_TYPE::StoneId].Textures[BLOCK_TYPE::SideUp]++;
+  BLOCK_TYPE::BuildFaceTextures();
+  BOOST_TEST(!Loaded.Load(Bytes.data(), Bytes.size()));
+  BLOCK_TYPE::Table[BLOCK_TYPE::StoneId].Textures[BLOCK_TYPE::SideUp]--;
+  BLOCK_TYPE::BuildFaceTextures();
+
+  /* Block type alpha changes */
+  BLOCK_TYPE::Table[BLOCK_TYPE::GlassId].Alpha = 0.5f;
+  BOOST_TEST(!Loaded.Load(Bytes.data(), Bytes.size()));
+
+  /* Same block types load mesh again */
+  BLOCK_TYPE::Table[BLOCK_TYPE::GlassId].Alpha = Types[BLOCK_TYPE::GlassId].Alpha;
+  BOOST_TEST(Loaded.Load(Bytes.data(), Bytes.size()));
+}
+
+BOOST_AUTO_TEST_CASE(key_changes_with_blocks_and_borders)
+{
+  BLOCK Stone;
+
+  Stone.BlockTypeId = BLOCK_TYPE::StoneId;
+
+  chunk_blocks Blocks, Same;
+
+  for (UINT32 i = 0; i < chunk_blocks::NumberOfBlocks; i += 3)
+  {
+    Blocks.Set(i, Stone);
+    Same.Set(i, Stone);
+  }
+
+  Blocks.Compact();
+  Same.Compact();
+
+  /* Equal blocks give equal key, edit changes it */
+  UINT64 BlocksHash = GetBlocksHash(Blocks);
+
+  BOOST_TEST(GetBlocksHash(Same) == BlocksHash);
+
+  Same.Set(1, Stone);
+  BOOST_TEST(GetBlocksHash(Same) != BlocksHash);
+
+  /* Not loaded neighbour and loaded neighbour without opaque blocks cull faces differently */
+  CHUNK_BORDERS NotLoaded, Loaded;
+  chunk_blocks Air;
+
+  for (UINT32 Face = 0; Face < BLOCK::NumberOfFaces; Face++)
+    chunk_mesher::GetBorder(Air, Face, Loaded.Opaque[Face]);
+
+  BOOST_TEST(NotLoaded.GetHash() != Loaded.GetHash());
+
+  for (UINT32 Face = 0; Face < BLOCK::NumberOfFaces; Face++)
+  {
+    CHUNK_BORDERS Changed = Loaded;
+
+    Changed.Opaque[Face][0] |= 1;
+    BOOST_TEST(Changed.GetHash() != Loaded.GetHash(), "face " << Face);
+
+    /* Borders of other faces aren't mixed */
+    if (Face > 0)
+    {
+      CHUNK_BORDERS Other = Loaded;
+
+      Other.Opaque[Face - 1][0] |= 1;
+      BOOST_TEST(Changed.GetHash() != Other.GetHash(), "face " << Face);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,445 @@
+#include <vector>
+#include <array>
+#include <map>
+#include <random>
+
+#include <boost/test/unit_test.hpp>
+
+#include "game_objects/chunk_blocks.h"
+#include "game_objects/block_type.h"
+#include "render/chunk_mesher.h"
+
+/** Number of textures in test texture table */
+static constexpr UINT32 NumberOfTextures = 5;
+
+/**
+ * \brief Block types textures without texture atlas fixture structure
+ */
+struct TEXTURES_FIXTURE
+{
+  /** Original block types table */
+  std::vector<BLOCK_TYPE> Types = BLOCK_TYPE::Table;
+
+  /** Original texture coordinates */
+  std::vector<std::array<glm::vec2, 4>> TexCoords = BLOCK_TYPE::TexCoords;
+
+  /** Original texture rectangles */
+  std::vector<glm::vec4> TexRects = BLOCK_TYPE::TexRects;
+
+  /**
+   * \brief Fixture constructor (stone, grass top, grass side, grass bottom and glass textures)
+   */
+  TEXTURES_FIXTURE( VOID )
+  {
+    BLOCK_TYPE::TexCoords.assign(NumberOfTextures, {glm::vec2(1, 1), glm::vec2(1, 0), glm::vec2(0, 0), glm::vec2(0, 1)});
+    BLOCK_TYPE::TexRects.clear();
+
+    for (UINT32 i = 0; i < NumberOfTextures; i++)
+      BLOCK_TYPE::TexRects.push_back(glm::vec4(i / (FLT)NumberOfTextures, 0, 1 / (FLT)NumberOfTextures, 1));
+
+    for (UINT32 Side = 0; Side < BLOCK_TYPE::NumberOfSides; Side++)
+    {
+      BLOCK_TYPE::Table[BLOCK_TYPE::StoneId].Textures[Side] = 0;
+      BLOCK_TYPE::Table[BLOCK_TYPE::GrassId].Textures[Side] = 2;
+      BLOCK_TYPE::Table[BLOCK_TYPE::GlassId].Textures[Side] = 4;
+    }
+
+    BLOCK_TYPE::Table[BLOCK_TYPE::GrassId].Textures[BLOCK_TYPE::SideUp] = 1;
+    BLOCK_TYPE::Table[BLOCK_TYPE::GrassId].Textures[BLOCK_TYPE::SideDown] = 3;
+
+    BLOCK_TYPE::BuildFaceTextures();
+  }
+
+  /**
+   * \brief Fixture destructor (restores tables)
+   */
+  ~TEXTURES_FIXTURE( VOID )
+  {
+    BLOCK_TYPE::Table = Types;
+    BLOCK_TYPE::TexCoords = TexCoords;
+    BLOCK_TYPE::TexRects = TexRects;
+    BLOCK_TYPE::BuildFaceTextures();
+  }
+};
+
+/**
+ * \brief Get block of type function
+ * \param[in] TypeId Block type identifier
+ * \param[in] Orientation Block orientation
+ * \return Block state
+ */
+static BLOCK GetBlock( UINT32 TypeId, BYTE Orientation = 0 )
+{
+  BLOCK Block;
+
+  Block.BlockTypeId = TypeId;
+  Block.Orientation = Orientation;
+
+  return Block;
+}
+
+/**
+ * \brief Fill chunk with random blocks function
+ * \param[out] Blocks Chunk blocks (must be empty)
+ * \param[in] Seed Random seed
+ * \param[in] AirPercent Percent of air blocks
+ */
+static VOID FillRandom( chunk_blocks &Blocks, UINT32 Seed, UINT32 AirPercent )
+{
+  std::mt19937 Random(Seed);
+  const UINT32 Types[] = {BLOCK_TYPE::StoneId, BLOCK_TYPE::GrassId, BLOCK_TYPE::GlassId};
+
+  for (UINT32 i = 0; i < chunk_blocks::NumberOfBlocks; i++)
+    if (Random() % 100 >= AirPercent)
+      Blocks.Set(i, GetBlock(Types[Random() % 3], Random() % BLOCK::NumberOfOrientations));
+
+  Blocks.Compact();
+}
+
+/**
+ * \brief Fill borders from random neighbours function (some neighbours are left not loaded)
+ * \param[out] Borders Neighbour borders
+ * \param[in] Seed Random seed
+ */
+static VOID FillRandomBorders( CHUNK_BORDERS &Borders, UINT32 Seed )
+{
+  for (UINT32 Face = 0; Face < BLOCK::NumberOfFaces; Face++)
+  {
+    if (Face % 3 == 2)
+    {
+      Borders.Opaque[Face].clear();
+      continue;
+    }
+
+    chunk_blocks Neighbour;
+
+    FillRandom(Neighbour, Seed + Face, 50);
+    chunk_mesher::GetBorder(Neighbour, Face, Borders.Opaque[Face]);
+  }
+}
+
+/**
+ * \brief Get vertex position in chunk function
+ * \param[in] Vertex Vertex
+ * \return Position in chunk
+ */
+static glm::ivec3 GetVertexPos( const VERTEX &Vertex )
+{
+  return VERTEX::UnpackPosition(Vertex.Position);
+}
+
+/**
+ * \brief Get quad corner from packed face function (same unpacking as packed_face.vert)
+ * \param[in] Face Packed face
+ * \param[in] Corner Corner index (0..3)
+ * \return Corner position in chunk
+ */
+static glm::ivec3 GetPackedCorner( UINT32 Face, UINT32 Corner )
+{
+  UINT32 Direction = (Face >> 16) & 7;
+  INT32 SizeA = ((Face >> 19) & 15) + 1;
+  INT32 SizeB = ((Face >> 23) & 15) + 1;
+  const chunk_mesher::FACE_AXES &Axes = chunk_mesher::GetFaceAxes(Direction);
+  glm::ivec3 Pos(Face & 15, (Face >> 4) & 255, (Face >> 12) & 15);
+
+  Pos[Axes.N] += Direction & 1;
+
+  if (Corner == 1 || Corner == 2)
+    Pos[Axes.A] += SizeA;
+  if (Corner == 2 || Corner == 3)
+    Pos[Axes.B] += SizeB;
+
+  return Pos;
+}
+
+/** Face cells covered by quads (key - face and block index, value - texture index) */
+using COVERAGE = std::map<std::pair<UINT32, UINT32>, UINT32>;
+
+/**
+ * \brief Get face cells covered by quads function
+ * \param[in] Quads Quads array
+ * \param[out] Coverage Covered face cells
+ * \return FALSE if any face cell is covered twice
+ */
+static BOOL GetCoverage( const std::vector<chunk_mesher::QUAD> &Quads, COVERAGE &Coverage )
+{
+  for (const chunk_mesher::QUAD &Quad : Quads)
+  {
+    const chunk_mesher::FACE_AXES &Axes = chunk_mesher::GetFaceAxes(Quad.Face);
+
+    for (UINT32 a = 0; a < Quad.SizeA; a++)
+      for (UINT32 b = 0; b < Quad.SizeB; b++)
+      {
+        glm::ivec3 Pos = Quad.Origin;
+
+        Pos[Axes.A] += a;
+        Pos[Axes.B] += b;
+
+        if (!Coverage.emplace(std::make_pair(Quad.Face, chunk_mesher::GetIndex(Pos)), Quad.Texture).second)
+          return FALSE;
+      }
+  }
+
+  return TRUE;
+}
+
+BOOST_AUTO_TEST_SUITE(chunk_mesher_tests)
+
+BOOST_FIXTURE_TEST_CASE(visibility_against_borders, TEXTURES_FIXTURE)
+{
+  chunk_blocks Full;
+
+  for (UINT32 i = 0; i < chunk_blocks::NumberOfBlocks; i++)
+    Full.Set(i, GetBlock(BLOCK_TYPE::StoneId));
+
+  Full.Compact();
+
+  CHUNK_BORDERS NotLoaded, Covered;
+
+  for (UINT32 Face = 0; Face < BLOCK::NumberOfFaces; Face++)
+    chunk_mesher::GetBorder(Full, Face, Covered.Opaque[Face]);
+
+  for (UINT32 Face = 0; Face < BLOCK::NumberOfFaces; Face++)
+  {
+    const chunk_mesher::FACE_AXES &Axes = chunk_mesher::GetFaceAxes(Face);
+    INT32 BorderLayer = (Face & 1) ? chunk_mesher::GetChunkSize(Axes.N) - 1 : 0;
+    chunk_mesher::VISIBILITY_MASK Visible {}, CoveredVisible {};
+
+    /* Only faces next to not loaded neighbour are visible in full chunk */
+    chunk_mesher::GetVisibilityMask(Full, NotLoaded, Face, Visible);
+    chunk_mesher::GetVisibilityMask(Full, Covered, Face, CoveredVisible);
+
+    for (INT32 z = 0; z < chunk_blocks::ChunkSizeZ; z++)
+      for (INT32 y = 0; y < chunk_blocks::ChunkSizeY; y++)
+        for (INT32 x = 0; x < chunk_blocks::ChunkSizeX; x++)
+        {
+          glm::ivec3 Pos(x, y, z);
+          UINT32 Index = chunk_mesher::GetIndex(Pos);
+          BOOL IsBorder = Pos[Axes.N] == BorderLayer;
+
+          BOOST_TEST_REQUIRE(((Visible[Index / 64] >> (Index % 64)) & 1) == (UINT64)IsBorder,
+                             "face " << Face << ", block " << Index);
+          BOOST_TEST_REQUIRE(chunk_mesher::IsFaceVisible(Full, NotLoaded, Pos, Face) == IsBorder);
+          BOOST_TEST_REQUIRE(((CoveredVisible[Index / 64] >> (Index % 64)) & 1) == 0u,
+                             "face " << Face << ", block " << Index);
+        }
+  }
+
+  /* One opaque neighbour block covers only face of adjacent block */
+  chunk_blocks Single;
+  glm::ivec3 Pos(0, 5, 7);
+
+  Single.Set(chunk_mesher::GetIndex(Pos), GetBlock(BLOCK_TYPE::StoneId));
+
+  CHUNK_BORDERS Borders;
+
+  Borders.Opaque[BLOCK::FaceLeft].assign(Covered.Opaque[BLOCK::FaceLeft].size(), 0);
+  BOOST_TEST(chunk_mesher::IsFaceVisible(Single, Borders, Pos, BLOCK::FaceLeft));
+
+  UINT32 Cell = chunk_mesher::GetBorderCell(Pos, BLOCK::FaceLeft);
+
+  BOOST_TEST((chunk_mesher::GetBorderPos(Cell, BLOCK::FaceLeft) == Pos));
+
+  Borders.Opaque[BLOCK::FaceLeft][Cell / 64] |= 1ull << (Cell % 64);
+  BOOST_TEST(!chunk_mesher::IsFaceVisible(Single, Borders, Pos, BLOCK::FaceLeft));
+  BOOST_TEST(chunk_mesher::IsFaceVisible(Single, Borders, Pos, BLOCK::FaceRight));
+  BOOST_TEST(!chunk_mesher::IsFaceVisible(Single, Borders, Pos + glm::ivec3(0, 1, 0), BLOCK::FaceLeft));
+}
+
+BOOST_FIXTURE_TEST_CASE(visibility_mask_matches_per_block_check, TEXTURES_FIXTURE)
+{
+  for (UINT32 Seed = 0; Seed < 3; Seed++)
+  {
+    chunk_blocks Blocks;
+    CHUNK_BORDERS Borders;
+
+    FillRandom(Blocks, Seed, 40 + Seed * 20);
+    FillRandomBorders(Borders, Seed * 10 + 100);
+
+    for (UINT32 Face = 0; Face < BLOCK::NumberOfFaces; Face++)
+    {
+      chunk_mesher::VISIBILITY_MASK Visible {};
+
+      chunk_mesher::GetVisibilityMask(Blocks, Borders, Face, Visible);
+
+      for (INT32 z = 0; z < chunk_blocks::ChunkSizeZ; z++)
+        for (INT32 y = 0; y < chunk_blocks::ChunkSizeY; y++)
+          for (INT32 x = 0; x < chunk_blocks::ChunkSizeX; x++)
+          {
+            UINT32 Index = chunk_mesher::GetIndex(glm::ivec3(x, y, z));
+            BOOL IsVisible = chunk_mesher::IsFaceVisible(Blocks, Borders, glm::ivec3(x, y, z), Face);
+
+            BOOST_TEST_REQUIRE(((Visible[Index / 64] >> (Index % 64)) & 1) == (UINT64)IsVisible,
+                               "seed " << Seed << ", face " << Face << ", block " << Index);
+          }
+    }
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE(pack_quad_round_trip, TEXTURES_FIXTURE)
+{
+  std::mt19937 Random(7);
+
+  for (UINT32 i = 0; i < 10000; i++)
+  {
+    chunk_mesher::QUAD Quad;
+
+    Quad.Face = Random() % BLOCK::NumberOfFaces;
+    Quad.Origin = glm::ivec3(Random() % chunk_blocks::ChunkSizeX, Random() % chunk_blocks::ChunkSizeY,
+                             Random() % chunk_blocks::ChunkSizeZ);
+    Quad.SizeA = Random() % 16 + 1;
+    Quad.SizeB = Random() % 16 + 1;
+    Quad.Texture = Random() % NumberOfTextures;
+    Quad.Alpha = 1;
+
+    VERTEX Vertices[4];
+    UINT32 Face = chunk_mesher::PackQuad(Quad);
+
+    chunk_mesher::GetQuadVertices(Quad, Vertices);
+
+    /* Shader rebuilds same corners and tile coordinates from packed face */
+    for (UINT32 Corner = 0; Corner < 4; Corner++)
+    {
+      glm::ivec3 Expected = GetVertexPos(Vertices[Corner]);
+      glm::ivec3 Unpacked = GetPackedCorner(Face, Corner);
+
+      BOOST_TEST_REQUIRE((Unpacked == Expected), "quad " << i << ", corner " << Corner);
+      BOOST_TEST_REQUIRE((Vertices[Corner].TexCoord ==
+                          BLOCK_TYPE::TexCoords[Quad.Texture][Corner] * glm::vec2(Quad.SizeB, Quad.SizeA)));
+    }
+
+    BOOST_TEST_REQUIRE(Face >> (32 - chunk_mesher::PackedTextureBits) == Quad.Texture);
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE(greedy_covers_per_face_cells, TEXTURES_FIXTURE)
+{
+  for (UINT32 Seed = 0; Seed < 3; Seed++)
+  {
+    chunk_blocks Blocks;
+    CHUNK_BORDERS Borders;
+
+    FillRandom(Blocks, Seed + 20, 30 + Seed * 25);
+    FillRandomBorders(Borders, Seed * 10 + 200);
+
+    for (UINT32 SectionId = 0; SectionId < chunk_blocks::NumberOfSections; SectionId++)
+    {
+      std::vector<chunk_mesher::QUAD> PerFace, Greedy;
+      COVERAGE PerFaceCoverage, GreedyCoverage;
+
+      chunk_mesher::BuildSectionQuads(Blocks, Borders, SectionId, PerFace, FALSE);
+      chunk_mesher::BuildSectionQuads(Blocks, Borders, SectionId, Greedy, TRUE);
+
+      BOOST_TEST_REQUIRE(GetCoverage(PerFace, PerFaceCoverage));
+      BOOST_TEST_REQUIRE(GetCoverage(Greedy, GreedyCoverage), "greedy quads overlap, section " << SectionId);
+      BOOST_TEST(PerFaceCoverage.size() == PerFace.size());
+      BOOST_TEST(Greedy.size() <= PerFace.size());
+
+      /* Merged quads cover same visible faces with same textures */
+      BOOST_TEST_REQUIRE((GreedyCoverage == PerFaceCoverage), "seed " << Seed << ", section " << SectionId);
+
+      for (const auto &[Key, Texture] : PerFaceCoverage)
+      {
+        glm::ivec3 Pos(Key.second % chunk_blocks::ChunkSizeX,
+                       Key.second / chunk_blocks::ChunkSizeX % chunk_blocks::ChunkSizeY,
+                       Key.second / (chunk_blocks::ChunkSizeX * chunk_blocks::ChunkSizeY));
+
+        BOOST_TEST_REQUIRE(Pos.y / chunk_blocks::SectionSize == (INT32)SectionId);
+        BOOST_TEST_REQUIRE(chunk_mesher::IsFaceVisible(Blocks, Borders, Pos, Key.first));
+        BOOST_TEST_REQUIRE(Texture == BLOCK_TYPE::GetFaceTexture(Blocks.Get(Key.second), Key.first));
+      }
+
+      /* Every visible face of section is covered */
+      UINT32 NumberOfVisible = 0;
+
+      for (INT32 z = 0; z < chunk_blocks::ChunkSizeZ; z++)
+        for (INT32 y = SectionId * chunk_blocks::SectionSize; y < (INT32)(SectionId + 1) * chunk_blocks::SectionSize; y++)
+          for (INT32 x = 0; x < chunk_blocks::ChunkSizeX; x++)
+            for (UINT32 Face = 0; Face < BLOCK::NumberOfFaces; Face++)
+              NumberOfVisible += chunk_mesher::IsFaceVisible(Blocks, Borders, glm::ivec3(x, y, z), Face);
+
+      BOOST_TEST(PerFaceCoverage.size() == NumberOfVisible);
+    }
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE(downsample_fills_half_full_cells, TEXTURES_FIXTURE)
+{
+  chunk_blocks Blocks;
+
+  /* Cell (0, 0, 0) of level 1: 4 of 8 blocks, glass above stone - filled with stone */
+  Blocks.Set(chunk_mesher::GetIndex(glm::ivec3(0, 0, 0)), GetBlock(BLOCK_TYPE::StoneId));
+  Blocks.Set(chunk_mesher::GetIndex(glm::ivec3(1, 0, 0)), GetBlock(BLOCK_TYPE::StoneId, 3));
+  Blocks.Set(chunk_mesher::GetIndex(glm::ivec3(0, 0, 1)), GetBlock(BLOCK_TYPE::StoneId));
+  Blocks.Set(chunk_mesher::GetIndex(glm::ivec3(1, 1, 1)), GetBlock(BLOCK_TYPE::GlassId));
+
+  /* Cell (2, 0, 0): 3 of 8 blocks - left air */
+  Blocks.Set(chunk_mesher::GetIndex(glm::ivec3(2, 0, 0)), GetBlock(BLOCK_TYPE::StoneId));
+  Blocks.Set(chunk_mesher::GetIndex(glm::ivec3(3, 0, 0)), GetBlock(BLOCK_TYPE::StoneId));
+  Blocks.Set(chunk_mesher::GetIndex(glm::ivec3(2, 1, 0)), GetBlock(BLOCK_TYPE::StoneId));
+
+  /* Cell (4, 0, 0): only glass - filled with glass */
+  for (INT32 y = 0; y < 2; y++)
+    for (INT32 x = 4; x < 6; x++)
+      Blocks.Set(chunk_mesher::GetIndex(glm::ivec3(x, y, 0)), GetBlock(BLOCK_TYPE::GlassId));
+
+  /* Cell (6, 0, 0): grass above stone - filled with highest opaque block */
+  Blocks.Set(chunk_mesher::GetIndex(glm::ivec3(6, 0, 0)), GetBlock(BLOCK_TYPE::StoneId));
+  Blocks.Set(chunk_mesher::GetIndex(glm::ivec3(7, 0, 0)), GetBlock(BLOCK_TYPE::StoneId));
+  Blocks.Set(chunk_mesher::GetIndex(glm::ivec3(6, 0, 1)), GetBlock(BLOCK_TYPE::StoneId));
+  Blocks.Set(chunk_mesher::GetIndex(glm::ivec3(7, 1, 1)), GetBlock(BLOCK_TYPE::GrassId));
+
+  Blocks.Compact();
+
+  chunk_blocks Coarse;
+
+  chunk_mesher::Downsample(Blocks, 1, Coarse);
+
+  for (INT32 z = 0; z < 2; z++)
+    for (INT32 y = 0; y < 2; y++)
+      for (INT32 x = 0; x < 8; x++)
+      {
+        BLOCK Block = Coarse.Get(chunk_mesher::GetIndex(glm::ivec3(x, y, z)));
+        UINT32 ExpectedType = x < 2 ? BLOCK_TYPE::StoneId : x < 4 ? BLOCK_TYPE::AirId :
+                              x < 6 ? BLOCK_TYPE::GlassId : BLOCK_TYPE::GrassId;
+
+        BOOST_TEST_REQUIRE(Block.BlockTypeId == ExpectedType, "block " << x << ", " << y << ", " << z);
+      }
+
+  /* First opaque block found in highest row fills cell */
+  BOOST_TEST(Coarse.Get(chunk_mesher::GetIndex(glm::ivec3(1, 1, 1))).Orientation == 0);
+
+  for (INT32 z = 2; z < chunk_blocks::ChunkSizeZ; z++)
+    BOOST_TEST_REQUIRE(Coarse.IsAir(chunk_mesher::GetIndex(glm::ivec3(0, 0, z))));
+}
+
+BOOST_FIXTURE_TEST_CASE(downsample_keeps_cells_uniform, TEXTURES_FIXTURE)
+{
+  chunk_blocks Blocks;
+
+  FillRandom(Blocks, 42, 50);
+
+  for (UINT32 Lod = 0; Lod < chunk_mesher::NumberOfLods; Lod++)
+  {
+    chunk_blocks Coarse;
+    const INT32 CellSize = 1 << Lod;
+
+    chunk_mesher::Downsample(Blocks, Lod, Coarse);
+
+    for (INT32 z = 0; z < chunk_blocks::ChunkSizeZ; z++)
+      for (INT32 y = 0; y < chunk_blocks::ChunkSizeY; y++)
+        for (INT32 x = 0; x < chunk_blocks::ChunkSizeX; x++)
+        {
+          glm::ivec3 Pos(x, y, z);
+          glm::ivec3 CellPos = Pos / CellSize * CellSize;
+
+          /* Level 0 keeps blocks, every coarser cell has one block */
+          if (Lod == 0)
+            BOOST_TEST_REQUIRE((Coarse.Get(chunk_mesher::GetIndex(Pos)) == Blocks.Get(chunk_mesher::GetIndex(Pos))));
+          else
+            BOOST_TEST_REQUIRE((Coarse.Get(chunk_mesher::GetIndex(Pos)) == Coarse.Get(chunk_mesher::GetIndex(CellPos))));
+        }
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
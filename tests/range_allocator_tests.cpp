@@ -0,0 +1,182 @@
+#include <vector>
+#include <map>
+#include <random>
+#include <algorithm>
+
+#include <boost/test/unit_test.hpp>
+
+#include "utils/range_allocator.h"
+
+/** Tested space size (power of 2, so whole space is allocated without class rounding) */
+static constexpr UINT64 Capacity = 1024;
+
+/**
+ * \brief Check allocated ranges are in space and don't overlap function
+ * \param[in] Allocator Range allocator
+ * \param[in] RangeIds Allocated range indices
+ * \return TRUE if ranges are valid
+ */
+static BOOL IsRangesValid( const range_allocator &Allocator, const std::vector<UINT32> &RangeIds )
+{
+  std::vector<std::pair<UINT64, UINT64>> Ranges;
+
+  for (UINT32 RangeId : RangeIds)
+    Ranges.push_back({Allocator.GetOffset(RangeId), Allocator.GetSize(RangeId)});
+
+  std::sort(Ranges.begin(), Ranges.end());
+
+  for (UINT64 i = 0; i < Ranges.size(); i++)
+    if (Ranges[i].first + Ranges[i].second > Capacity ||
+        (i > 0 && Ranges[i - 1].first + Ranges[i - 1].second > Ranges[i].first))
+      return FALSE;
+
+  return TRUE;
+}
+
+BOOST_AUTO_TEST_SUITE(range_allocator_tests)
+
+BOOST_AUTO_TEST_CASE(allocate_until_full)
+{
+  range_allocator Allocator(Capacity);
+  std::vector<UINT32> RangeIds;
+
+  while (std::optional<UINT32> RangeId = Allocator.Allocate(8))
+  {
+    BOOST_TEST_REQUIRE(Allocator.GetSize(*RangeId) == 8u);
+    RangeIds.push_back(*RangeId);
+  }
+
+  BOOST_TEST(RangeIds.size() == Capacity / 8);
+  BOOST_TEST(IsRangesValid(Allocator, RangeIds));
+  BOOST_TEST(!Allocator.Allocate(1));
+
+  range_allocator::STATS Stats = Allocator.GetStats();
+
+  BOOST_TEST(Stats.AllocatedSize == Capacity);
+  BOOST_TEST(Stats.NumberOfAllocations == Capacity / 8);
+  BOOST_TEST(Stats.NumberOfFreeRanges == 0u);
+  BOOST_TEST(Stats.LargestFreeRange == 0u);
+}
+
+BOOST_AUTO_TEST_CASE(free_merges_neighbours)
+{
+  range_allocator Allocator(Capacity);
+  std::optional<UINT32> First = Allocator.Allocate(16), Second = Allocator.Allocate(16), Third = Allocator.Allocate(16);
+
+  BOOST_TEST_REQUIRE((First && Second && Third));
+
+  /* Hole between allocated ranges isn't merged with tail */
+  Allocator.Free(*Second);
+  BOOST_TEST(Allocator.GetStats().NumberOfFreeRanges == 2u);
+
+  /* Previous neighbour is merged with hole */
+  Allocator.Free(*First);
+
+  range_allocator::STATS Stats = Allocator.GetStats();
+
+  BOOST_TEST(Stats.NumberOfFreeRanges == 2u);
+  BOOST_TEST(Stats.LargestFreeRange == Capacity - 48);
+
+  /* Range between two free ranges joins them into whole space */
+  Allocator.Free(*Third);
+  Stats = Allocator.GetStats();
+
+  BOOST_TEST(Stats.NumberOfFreeRanges == 1u);
+  BOOST_TEST(Stats.LargestFreeRange == Capacity);
+  BOOST_TEST(Stats.AllocatedSize == 0u);
+  BOOST_TEST(Stats.NumberOfAllocations == 0u);
+
+  std::optional<UINT32> Whole = Allocator.Allocate(Capacity);
+
+  BOOST_TEST_REQUIRE(Whole.has_value());
+  BOOST_TEST(Allocator.GetOffset(*Whole) == 0u);
+}
+
+BOOST_AUTO_TEST_CASE(fragmented_space_rejects_large_range)
+{
+  range_allocator Allocator(Capacity);
+  std::vector<UINT32> RangeIds, Kept;
+
+  while (std::optional<UINT32> RangeId = Allocator.Allocate(8))
+    RangeIds.push_back(*RangeId);
+
+  /* Every other range is freed - half of space is free, but no free range is larger than 8 */
+  for (UINT64 i = 0; i < RangeIds.size(); i++)
+    if (i % 2 == 0)
+      Allocator.Free(RangeIds[i]);
+    else
+      Kept.push_back(RangeIds[i]);
+
+  range_allocator::STATS Stats = Allocator.GetStats();
+
+  BOOST_TEST(Stats.AllocatedSize == Capacity / 2);
+  BOOST_TEST(Stats.NumberOfFreeRanges == Capacity / 16);
+  BOOST_TEST(Stats.LargestFreeRange == 8u);
+  BOOST_TEST(!Allocator.Allocate(9));
+
+  std::optional<UINT32> RangeId = Allocator.Allocate(8);
+
+  BOOST_TEST_REQUIRE(RangeId.has_value());
+  Kept.push_back(*RangeId);
+  BOOST_TEST(IsRangesValid(Allocator, Kept));
+}
+
+BOOST_AUTO_TEST_CASE(random_allocate_free_keeps_invariants)
+{
+  std::mt19937 Random(7);
+  range_allocator Allocator(Capacity);
+  std::vector<UINT32> RangeIds;
+  std::map<UINT32, UINT64> Sizes;
+  UINT64 AllocatedSize = 0;
+
+  for (UINT32 Step = 0; Step < 5000; Step++)
+  {
+    if (RangeIds.empty() || Random() % 3 != 0)
+    {
+      UINT64 Size = Random() % 100 + 1;
+      std::optional<UINT32> RangeId = Allocator.Allocate(Size);
+
+      if (RangeId)
+      {
+        BOOST_TEST_REQUIRE(Allocator.GetSize(*RangeId) == Size);
+        BOOST_TEST_REQUIRE(Sizes.count(*RangeId) == 0u, "range " << *RangeId << " is allocated twice");
+        RangeIds.push_back(*RangeId);
+        Sizes[*RangeId] = Size;
+        AllocatedSize += Size;
+      }
+      else
+        BOOST_TEST_REQUIRE(Allocator.GetStats().LargestFreeRange < Size * 2, "step " << Step);
+    }
+    else
+    {
+      UINT64 Index = Random() % RangeIds.size();
+
+      Allocator.Free(RangeIds[Index]);
+      AllocatedSize -= Sizes[RangeIds[Index]];
+      Sizes.erase(RangeIds[Index]);
+      RangeIds[Index] = RangeIds.back();
+      RangeIds.pop_back();
+    }
+
+    range_allocator::STATS Stats = Allocator.GetStats();
+
+    BOOST_TEST_REQUIRE(Stats.AllocatedSize == AllocatedSize, "step " << Step);
+    BOOST_TEST_REQUIRE(Stats.NumberOfAllocations == RangeIds.size(), "step " << Step);
+    BOOST_TEST_REQUIRE(Stats.LargestFreeRange <= Capacity - AllocatedSize, "step " << Step);
+
+    /* Merged free ranges are never adjacent, so every free range except last is followed by allocated one */
+    BOOST_TEST_REQUIRE(Stats.NumberOfFreeRanges <= RangeIds.size() + 1, "step " << Step);
+    BOOST_TEST_REQUIRE(IsRangesValid(Allocator, RangeIds), "step " << Step);
+  }
+
+  for (UINT32 RangeId : RangeIds)
+    Allocator.Free(RangeId);
+
+  range_allocator::STATS Stats = Allocator.GetStats();
+
+  BOOST_TEST(Stats.NumberOfFreeRanges == 1u);
+  BOOST_TEST(Stats.LargestFreeRange == Capacity);
+  BOOST_TEST(Stats.AllocatedSize == 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()